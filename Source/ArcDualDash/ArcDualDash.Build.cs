@@ -15,6 +15,12 @@ public class ArcDualDash : ModuleRules
 		"Engine",
 		"InputCore",
 		"EnhancedInput",
+		"NetCore",    // <-- fast-array leaderboard replication
+		"PhysicsCore",
+		"Chaos",         // <-- async physics step (AMyCar custom forces)
+		"ChaosVehicles",
+		"DeveloperSettings", // <-- URaceSettings (Project Settings -> Race)
+		"Niagara",    // <-- pooled race FX (URaceFXPoolSubsystem)
 		"UMG",        // <-- UI widgets
 		"Slate",      // <-- required by UMG
 		"SlateCore"   // <-- required by UMG
@@ -22,6 +28,12 @@ public class ArcDualDash : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+		// RaceTrackBake / RaceLineBake commandlets (asset saving / WP actor loading)
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "AssetRegistry", "EngineSettings" });
+		}
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 		
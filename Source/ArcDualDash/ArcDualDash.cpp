@@ -1,6 +1,23 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ArcDualDash.h"
+#include "RaceMallocCounter.h"
+#include "Misc/CommandLine.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ArcDualDash, "ArcDualDash" );
+class FArcDualDashModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if RACE_MALLOC_COUNTER
+		// notes: as early as game code runs, before any race world exists (see RaceMallocCounter.h)
+		if (FParse::Param(FCommandLine::Get(), TEXT("RaceMallocCounter")))
+		{
+			RaceMallocCounter::Install();
+		}
+#endif
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FArcDualDashModule, ArcDualDash, "ArcDualDash" );
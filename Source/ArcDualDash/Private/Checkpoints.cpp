@@ -4,16 +4,21 @@
 // ============================================================================
 #include "Checkpoints.h"
 #include "MyCar.h" // notes: to call LapCheckpoint on overlap
+#include "RaceCollision.h"
 
 // Sets default values
 ACheckpoints::ACheckpoints()
 {
     PrimaryActorTick.bCanEverTick = true;
 
+    // notes: static track actor; level GC clusters keep it out of reachability analysis
+    bCanBeInCluster = true;
+
     // notes: create BOX TRIGGER Volume per lab
     Volume = CreateDefaultSubobject<UBoxComponent>(TEXT("Volume"));
     Volume->InitBoxExtent(FVector(100.f, 400.f, 500.f)); // tune in editor
-    Volume->SetCollisionResponseToAllChannels(ECR_Overlap);
+    // notes: RaceGate only overlaps RaceCar (RaceCollision.h); no pairs with the world or other triggers
+    Volume->SetCollisionProfileName(RaceCollision::GateProfile);
     Volume->SetGenerateOverlapEvents(true);
     SetRootComponent(Volume);
 }
@@ -40,6 +45,14 @@ void ACheckpoints::Tick(float DeltaTime)
 void ACheckpoints::OnVolumeBeginOverlap(UPrimitiveComponent* /*OverlappedComponent*/, AActor* OtherActor,
     UPrimitiveComponent* /*OtherComp*/, int32 /*OtherBodyIndex*/, bool /*bFromSweep*/, const FHitResult& /*SweepResult*/)
 {
+    // notes: server owns lap/checkpoint validation; clients get Lap via replication
+    if (!HasAuthority())
+    {
+        return;
+    }
+
+    RaceCollision::CountOverlapEvent(ERaceOverlapSource::Gate);
+
     if (AMyCar* Car = Cast<AMyCar>(OtherActor))
     {
         Car->LapCheckpoint(CheckPointNo, MaxCheckPoints, bStartFinishLine);
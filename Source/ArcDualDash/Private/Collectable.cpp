@@ -1,23 +1,35 @@
 #include "Collectable.h"
+#include "RaceMemory.h"
 #include "MyCar.h"
+#include "RaceCollision.h"
+#include "RaceEventBus.h"
+#include "RaceFXPoolSubsystem.h"
+#include "RaceSettings.h"
+#include "Net/UnrealNetwork.h"
 
 ACollectable::ACollectable()
 {
+	LLM_SCOPE_BYTAG(Race_Collectables);
+
 	PrimaryActorTick.bCanEverTick = false;
 
+	// --- networking: static pickup, wake only when consumed ---
+	bReplicates = true;
+	SetReplicatingMovement(false);
+	NetDormancy = DORM_Initial;
+
+	// notes: placed in the level and (in a quiet race) never destroyed -> fine in a GC cluster
+	bCanBeInCluster = true;
+
 	// --- root ---
 	RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 	SetRootComponent(RootComp);
 
-	// --- trigger sphere (overlap Vehicle / Pickup) ---
+	// --- trigger sphere (Pickup channel, overlaps RaceCar only; see RaceCollision.h) ---
 	Sphere = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
 	Sphere->SetupAttachment(RootComp);
 	Sphere->InitSphereRadius(100.f);
-	Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-
-	Sphere->SetCollisionProfileName(TEXT("Pickup"));
-
-
+	Sphere->SetCollisionProfileName(RaceCollision::PickupProfile);
 	Sphere->SetGenerateOverlapEvents(true);
 
 	// --- visual mesh (no collision) ---
@@ -30,17 +42,59 @@ ACollectable::ACollectable()
 
 void ACollectable::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Race_Collectables);
+
 	Super::BeginPlay();
 	if (ensure(Sphere))
 	{
 		Sphere->OnComponentBeginOverlap.AddDynamic(this, &ACollectable::OnSphereBeginOverlap);
 		Sphere->UpdateOverlaps();
 	}
+
+	if (URaceSignificanceSubsystem* SignificanceSys = GetWorld()->GetSubsystem<URaceSignificanceSubsystem>())
+	{
+		SignificanceSys->RegisterCollectable(this);
+	}
+}
+
+void ACollectable::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URaceSignificanceSubsystem* SignificanceSys = GetWorld()->GetSubsystem<URaceSignificanceSubsystem>())
+	{
+		SignificanceSys->UnregisterCollectable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACollectable::ApplySignificance(ERaceSignificance NewSignificance)
+{
+	if (NewSignificance == Significance) return;
+	Significance = NewSignificance;
+
+	// notes: BP children may spin/bob in Tick -> throttle it; shadows only when big on screen
+	SetActorTickInterval(URaceSignificanceSubsystem::GetTickIntervalFor(NewSignificance));
+	if (Mesh)
+	{
+		Mesh->SetCastShadow(NewSignificance == ERaceSignificance::High);
+	}
+}
+
+void ACollectable::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ACollectable, bConsumed);
 }
 
 void ACollectable::OnSphereBeginOverlap(UPrimitiveComponent*, AActor* OtherActor,
 	UPrimitiveComponent*, int32, bool, const FHitResult&)
 {
+	RaceCollision::CountOverlapEvent(ERaceOverlapSource::Pickup);
+
+	// notes: pickups are granted by the server only
+	if (!HasAuthority() || bConsumed) return;
+
 	AMyCar* Car = Cast<AMyCar>(OtherActor);
 	if (!Car) return;
 
@@ -54,15 +108,43 @@ void ACollectable::OnSphereBeginOverlap(UPrimitiveComponent*, AActor* OtherActor
 		Car->StartSpeedBoost(BoostDuration, BoostForce);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[Collectable] picked by %s (+%d, boost=%s %.1fs %.0f)"),
+	URaceEventBusSubsystem::Emit(Car, ERaceEventType::Pickup, ScoreValue, bGivesSpeedBoost ? BoostDuration : 0.f);
+
+	UE_LOG(LogTemp, Verbose, TEXT("[Collectable] picked by %s (+%d, boost=%s %.1fs %.0f)"),
 		*GetNameSafe(Car), ScoreValue, bGivesSpeedBoost ? TEXT("yes") : TEXT("no"), BoostDuration, BoostForce);
 
 	ConsumePickup();
 }
 
 void ACollectable::ConsumePickup()
+{
+	// notes: wake from dormancy so the consumed flag goes out once, then destroy
+	//        (quiet race: stays hidden, no actor teardown mid-race)
+	FlushNetDormancy();
+	bConsumed = true;
+
+	ApplyConsumedState();
+	if (!URaceSettings::Get()->bGCQuietRace)
+	{
+		SetLifeSpan(0.1f);
+	}
+}
+
+void ACollectable::OnRep_Consumed()
+{
+	if (bConsumed)
+	{
+		ApplyConsumedState();
+	}
+}
+
+void ACollectable::ApplyConsumedState()
 {
 	SetActorEnableCollision(false);
 	SetActorHiddenInGame(true);
-	SetLifeSpan(0.1f);
+
+	if (URaceFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<URaceFXPoolSubsystem>())
+	{
+		FXPool->SpawnFX(ERaceFX::Pickup, GetActorLocation(), GetActorRotation());
+	}
 }
@@ -1,6 +1,16 @@
 ﻿#include "MyCar.h"
+#include "RaceMemory.h"
+#include "RaceCollision.h"
 #include "RaceGameState.h"
+#include "RaceLineData.h"
 #include "RacePlayerController.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
+#include "RaceEventBus.h"
+#include "RaceFXPoolSubsystem.h"
+#include "RaceLogicSubsystem.h"
+#include "RaceReplaySubsystem.h"
+#include "RaceResultsSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Controller.h"
 #include "EnhancedInputComponent.h"
@@ -9,29 +19,46 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "Particles/ParticleSystem.h"
+#include "Net/UnrealNetwork.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#include "Chaos/ParticleHandle.h"
 #include "TimerManager.h"
 
 AMyCar::AMyCar()
 {
+	LLM_SCOPE_BYTAG(Race_Vehicles);
+
 	PrimaryActorTick.bCanEverTick = true;
 
-	// Optional crash trigger component
+	// Custom forces run on the fixed async physics step (Project Settings -> Physics -> Tick Async)
+	bAsyncPhysicsTickEnabled = true;
+
+	// Body: RaceCar blocks cars + world, overlaps gates / pickups / crash sensors (RaceCollision.h)
+	if (USkeletalMeshComponent* CarMesh = GetMesh())
+	{
+		CarMesh->SetCollisionProfileName(RaceCollision::CarProfile);
+	}
+
+	// Optional crash trigger component: CrashSensor overlaps cars and world only, never gates / pickups
 	CrashTrigger = CreateDefaultSubobject<UBoxComponent>(TEXT("CrashTrigger"));
 	if (CrashTrigger)
 	{
 		CrashTrigger->SetupAttachment(GetMesh());
 		CrashTrigger->SetBoxExtent(FVector(120.f, 80.f, 50.f));
-		CrashTrigger->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-		CrashTrigger->SetCollisionResponseToAllChannels(ECR_Overlap);
+		CrashTrigger->SetCollisionProfileName(RaceCollision::CrashSensorProfile);
 	}
 }
 
 void AMyCar::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Race_Vehicles);
+
 	Super::BeginPlay();
 
-	// --- Assign PlayerID ---
-	if (APlayerController* PC = Cast<APlayerController>(GetController()))
+	// --- Assign PlayerID (server side, replicated to clients) ---
+	APlayerController* OwningPC = HasAuthority() ? Cast<APlayerController>(GetController()) : nullptr;
+	if (APlayerController* PC = OwningPC)
 	{
 		if (ARacePlayerController* RPC = Cast<ARacePlayerController>(PC))
 		{
@@ -66,6 +93,21 @@ void AMyCar::BeginPlay()
 
 	UE_LOG(LogTemp, Log, TEXT("[MyCar] Bound collision + overlap events for crash detection."));
 
+	// --- Snapshot drag params for the physics step (read there, never written) ---
+	if (const auto* Move = Cast<UChaosWheeledVehicleMovementComponent>(GetVehicleMovementComponent()))
+	{
+		PT_DragCoefficient = Move->DragCoefficient;
+		PT_DragAreaM2 = (Move->ChassisWidth * Move->ChassisHeight) / 10000.f; // cm^2 -> m^2
+	}
+	PT_BoostDragScale = BoostDragScale;
+	PT_SlipstreamDragScale = SlipstreamDragScale;
+	PT_SlipstreamAccel = SlipstreamAccel;
+
+	if (!UPhysicsSettings::Get()->bTickPhysicsAsync)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[MyCar] Async physics tick is off; boost / respawn nudge forces will not run"));
+	}
+
 	// --- Input mapping setup ---
 	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{
@@ -82,25 +124,36 @@ void AMyCar::BeginPlay()
 		}
 	}
 
-	// --- Cache checkpoints ---
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ACheckpoints::StaticClass(), FoundActors);
+	if (URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>())
+	{
+		Vehicles->RegisterCar(this);
+	}
+}
 
-	AllCheckpoints.Empty();
-	for (AActor* Actor : FoundActors)
+void AMyCar::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>())
 	{
-		if (ACheckpoints* CP = Cast<ACheckpoints>(Actor))
-		{
-			AllCheckpoints.Add(CP);
-		}
+		Vehicles->UnregisterCar(this);
 	}
+	ReleaseBoostTrail();
 
-	AllCheckpoints.Sort([](const ACheckpoints& A, const ACheckpoints& B)
-		{
-			return A.CheckPointNo < B.CheckPointNo;
-		});
+	Super::EndPlay(EndPlayReason);
+}
 
-	UE_LOG(LogTemp, Log, TEXT("[MyCar] Found %d checkpoints for tracking."), AllCheckpoints.Num());
+void AMyCar::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AMyCar, PlayerID);
+	DOREPLIFETIME(AMyCar, Lap);
+	DOREPLIFETIME(AMyCar, CurrentCheckpointIndex);
+	DOREPLIFETIME(AMyCar, GapToLeader);
+	DOREPLIFETIME(AMyCar, IntervalToAhead);
+	DOREPLIFETIME(AMyCar, bIsCrashed);
+	DOREPLIFETIME(AMyCar, bBoostTrail);
+	DOREPLIFETIME(AMyCar, bOffTrack);
+	DOREPLIFETIME(AMyCar, TrackLimitCuts);
 }
 
 // ---------------------------------------------------------
@@ -110,30 +163,191 @@ void AMyCar::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	if (bBoostActive && GetMesh())
+	if (SimLOD == ERaceSimLOD::Proxy)
 	{
-		const FVector Fwd = GetActorForwardVector();
-		GetMesh()->AddForce(Fwd * BoostForce, NAME_None, true);
+		TickProxySim(DeltaSeconds);
 	}
 
-	// --- Update distance to next checkpoint ---
-	if (AllCheckpoints.Num() > 0)
+	// --- Boost ends on the physics step; mirror it once physics has seen our last request ---
+	if (bBoostActive
+		&& BoostAckSeq.load() == BoostRequestSeq.load()
+		&& !bPhysBoostActive.load())
+	{
+		bBoostActive = false;
+		SetBoostTrail(false);
+		URaceEventBusSubsystem::Emit(this, ERaceEventType::BoostEnd);
+		UE_LOG(LogTemp, Verbose, TEXT("[MyCar] BOOST OFF"));
+	}
+}
+
+// ---------------------------------------------------------
+// Fixed-rate race logic (URaceLogicSubsystem, RaceLogicHz)
+// ---------------------------------------------------------
+void AMyCar::FixedRaceTick(float StepSeconds)
+{
+	// --- Distance to next checkpoint (gates come from the baked track data) ---
+	PrevDistanceToNextCheckpoint = DistanceToNextCheckpoint;
+	PrevNextGateIndex = NextGateIndex;
+
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	if (const URaceTrackData* Track = GS ? GS->GetTrackData() : nullptr)
 	{
-		int32 NextIndex = (CurrentCheckpointIndex + 1) % AllCheckpoints.Num();
-		if (AllCheckpoints.IsValidIndex(NextIndex))
+		if (Track->Gates.Num() > 0)
 		{
-			if (ACheckpoints* NextCheckpoint = AllCheckpoints[NextIndex])
-			{
-				DistanceToNextCheckpoint = FVector::Dist(GetActorLocation(), NextCheckpoint->GetActorLocation());
-			}
+			NextGateIndex = (CurrentCheckpointIndex + 1) % Track->Gates.Num();
+			DistanceToNextCheckpoint = FVector::Dist(GetActorLocation(), Track->Gates[NextGateIndex].Location);
 		}
 	}
 
 	if (IsPlayerControlled())
 	{
-		LocalElapsedTime += DeltaSeconds;
+		LocalElapsedTime = GetLocalElapsedTimeNow();
 		OnTimeUpdatedLocal.Broadcast(LocalElapsedTime);
 	}
+
+	if (bLineDriver && HasAuthority() && !bIsCrashed && SimLOD != ERaceSimLOD::Proxy)
+	{
+		TickLineDriver(StepSeconds);
+	}
+}
+
+float AMyCar::GetDisplayDistanceToNextCheckpoint() const
+{
+	// a gate change between steps is a jump, not something to blend across
+	const URaceLogicSubsystem* Logic = URaceLogicSubsystem::Get(this);
+	if (!Logic || PrevNextGateIndex != NextGateIndex)
+	{
+		return DistanceToNextCheckpoint;
+	}
+	return FMath::Lerp(PrevDistanceToNextCheckpoint, DistanceToNextCheckpoint, Logic->GetAlpha());
+}
+
+float AMyCar::GetDisplayLocalElapsedTime() const
+{
+	// already real time, like ARaceGameState::GetDisplayElapsedTime
+	return IsPlayerControlled() ? GetLocalElapsedTimeNow() : LocalElapsedTime;
+}
+
+float AMyCar::GetLocalElapsedTimeNow() const
+{
+	// race clock (frozen once the race ends), so it matches the server on every machine
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	return GS ? FMath::Max(0.f, GS->GetDisplayElapsedTime() - LocalStartTime) : LocalElapsedTime;
+}
+
+void AMyCar::TickLineDriver(float StepSeconds)
+{
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	const FRaceTrackLine* Line = GS ? &GS->GetGuideLine() : nullptr;
+	if (!Line || !Line->IsValid())
+		return;
+
+	const FVector Loc = GetActorLocation();
+	const float Distance = LineDriverSegment == INDEX_NONE
+		? Line->Project(Loc, &LineDriverSegment)
+		: Line->ProjectNear(Loc, LineDriverSegment, /*SearchRadius*/2, &LineDriverSegment);
+	const float Speed = GetPhysicsSpeed();
+
+	// --- steer at a point on the line, further ahead the faster we go ---
+	FVector AimLoc, AimDir;
+	Line->Sample(Line->WrapDistance(Distance + FMath::Max(Speed * LineDriverLookAhead, 800.f)), AimLoc, AimDir);
+	const FVector Forward = GetActorForwardVector().GetSafeNormal2D();
+	const FVector ToAim = (AimLoc - Loc).GetSafeNormal2D();
+	const float Angle = FMath::Atan2(FVector::CrossProduct(Forward, ToAim).Z, FVector::DotProduct(Forward, ToAim));
+
+	// --- speed: baked racing line targets, else cruise speed eased off by the aim angle ---
+	const URaceLineData* RacingLine = GS->GetRacingLine();
+	const float TargetSpeed = RacingLine
+		? RacingLine->GetTargetSpeed(Distance)
+		: LineDriverCruiseSpeed * FMath::Lerp(1.f, 0.4f, FMath::Min(FMath::Abs(Angle) / HALF_PI, 1.f));
+
+	FRaceDriveInput Input;
+	Input.Steering = FMath::Clamp(Angle * 2.f, -1.f, 1.f); // full lock ~30 degrees off the aim point
+	Input.Throttle = Speed < TargetSpeed ? 1.f : 0.f;
+	Input.Brake = Speed > TargetSpeed * 1.1f ? 1.f : 0.f;
+	SetDriveInput(Input);
+
+	// --- wedged against something: back onto the track ---
+	LineDriverStuckTime = Speed < 100.f ? LineDriverStuckTime + StepSeconds : 0.f;
+	if (LineDriverStuckTime > LineDriverStuckSeconds)
+	{
+		RespawnCar();
+	}
+}
+
+// ---------------------------------------------------------
+// Async physics step (physics thread, fixed dt)
+// notes: only touch the PT_* members, the atomics and the body handle here
+// ---------------------------------------------------------
+void AMyCar::AsyncPhysicsTickActor(float DeltaTime, float SimTime)
+{
+	Super::AsyncPhysicsTickActor(DeltaTime, SimTime);
+
+	FBodyInstance* BI = GetMesh() ? GetMesh()->GetBodyInstance() : nullptr;
+	Chaos::FSingleParticlePhysicsProxy* Proxy = BI ? BI->GetPhysicsActorHandle() : nullptr;
+	Chaos::FRigidBodyHandle_Internal* Body = Proxy ? Proxy->GetPhysicsThreadAPI() : nullptr;
+	if (!Body)
+	{
+		return;
+	}
+
+	// --- Pick up new requests from the game thread ---
+	const uint32 BoostSeq = BoostRequestSeq.load();
+	if (BoostSeq != PT_BoostSeq)
+	{
+		PT_BoostSeq = BoostSeq;
+		PT_BoostRemaining = PendingBoostSeconds.load();
+		PT_BoostForce = PendingBoostForce.load();
+	}
+
+	const FVector Fwd = Body->R().RotateVector(FVector::ForwardVector);
+
+	const uint32 NudgeSeq = NudgeRequestSeq.load();
+	if (NudgeSeq != PT_NudgeSeq)
+	{
+		PT_NudgeSeq = NudgeSeq;
+		Body->SetV(Fwd * PendingRespawnNudge.load());
+	}
+
+	const FVector Vel = Body->V();
+	const float Speed = Vel.Size();
+
+	// --- Boost + slipstream: extra push along heading, part of Chaos' aero drag handed back ---
+	FVector Force = FVector::ZeroVector;
+	float DragScale = 1.f;
+
+	if (PT_BoostRemaining > 0.f)
+	{
+		// boost: constant acceleration along heading (same as old AddForce(..., bAccelChange=true))
+		Force += Fwd * (PT_BoostForce * Body->M());
+		DragScale = PT_BoostDragScale;
+		PT_BoostRemaining = FMath::Max(0.f, PT_BoostRemaining - DeltaTime);
+	}
+
+	const float Draft = SlipstreamStrength.load(std::memory_order_relaxed);
+	if (Draft > 0.f)
+	{
+		Force += Fwd * (PT_SlipstreamAccel * Draft * Body->M());
+		DragScale = FMath::Min(DragScale, FMath::Lerp(1.f, PT_SlipstreamDragScale, Draft));
+	}
+
+	// drag relief: hand back (1 - DragScale) of Chaos' aero drag 0.5*rho*Cd*A*v^2
+	if (DragScale < 1.f && Speed > KINDA_SMALL_NUMBER)
+	{
+		const float SpeedMS = Speed / 100.f;
+		const float DragN = 0.5f * 1.225f * PT_DragCoefficient * PT_DragAreaM2 * SpeedMS * SpeedMS;
+		Force += (Vel / Speed) * (DragN * (1.f - DragScale) * 100.f); // N -> kg*cm/s^2
+	}
+
+	if (!Force.IsZero())
+	{
+		Body->AddForce(Force);
+	}
+
+	// --- Publish for HUD / game thread ---
+	PhysSpeed.store(Speed, std::memory_order_relaxed);
+	bPhysBoostActive.store(PT_BoostRemaining > 0.f);
+	BoostAckSeq.store(PT_BoostSeq);
 }
 
 // ---------------------------------------------------------
@@ -175,32 +389,56 @@ void AMyCar::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 // ---------------------------------------------------------
 void AMyCar::Move(const FInputActionValue& Value)
 {
-	FVector2D MovementVector = Value.Get<FVector2D>();
-	GetVehicleMovementComponent()->SetThrottleInput(MovementVector.Y);
-
-	if (MovementVector.Y < 0)
-		GetVehicleMovementComponent()->SetBrakeInput(-MovementVector.Y);
-	else
-		GetVehicleMovementComponent()->SetBrakeInput(0);
+	const FVector2D MovementVector = Value.Get<FVector2D>();
 
-	GetVehicleMovementComponent()->SetSteeringInput(MovementVector.X);
+	FRaceDriveInput Input = DriveInput;
+	Input.Throttle = MovementVector.Y;
+	Input.Brake = MovementVector.Y < 0.f ? -MovementVector.Y : 0.f;
+	Input.Steering = MovementVector.X;
+	ApplyDriveInput(Input);
 }
 
 void AMyCar::MoveEnd()
 {
-	GetVehicleMovementComponent()->SetBrakeInput(0);
-	GetVehicleMovementComponent()->SetThrottleInput(0);
-	GetVehicleMovementComponent()->SetSteeringInput(0);
+	FRaceDriveInput Input = DriveInput;
+	Input.Throttle = 0.f;
+	Input.Brake = 0.f;
+	Input.Steering = 0.f;
+	ApplyDriveInput(Input);
 }
 
 void AMyCar::OnHandbrakePressed()
 {
-	GetVehicleMovementComponent()->SetHandbrakeInput(true);
+	FRaceDriveInput Input = DriveInput;
+	Input.bHandbrake = true;
+	ApplyDriveInput(Input);
 }
 
 void AMyCar::OnHandbrakeReleased()
 {
-	GetVehicleMovementComponent()->SetHandbrakeInput(false);
+	FRaceDriveInput Input = DriveInput;
+	Input.bHandbrake = false;
+	ApplyDriveInput(Input);
+}
+
+void AMyCar::ApplyDriveInput(const FRaceDriveInput& Input)
+{
+	// during a replay the recorded stream is the only driver
+	if (URaceReplaySubsystem::IsReplaying(this))
+		return;
+
+	SetDriveInput(Input);
+}
+
+void AMyCar::SetDriveInput(const FRaceDriveInput& Input)
+{
+	DriveInput = Input;
+
+	UChaosVehicleMovementComponent* Movement = GetVehicleMovementComponent();
+	Movement->SetThrottleInput(Input.Throttle);
+	Movement->SetBrakeInput(Input.Brake);
+	Movement->SetSteeringInput(Input.Steering);
+	Movement->SetHandbrakeInput(Input.bHandbrake);
 }
 
 // ---------------- P2 proxy ----------------
@@ -214,38 +452,25 @@ static AMyCar* GetP2Car(const UObject* WorldContext)
 void AMyCar::Move_P2(const FInputActionValue& Value)
 {
 	if (AMyCar* P2 = GetP2Car(this))
-	{
-		const FVector2D Axis = Value.Get<FVector2D>();
-		auto* Move = P2->GetVehicleMovementComponent();
-
-		Move->SetThrottleInput(Axis.Y);
-		if (Axis.Y < 0.f) Move->SetBrakeInput(-Axis.Y);
-		else Move->SetBrakeInput(0.f);
-		Move->SetSteeringInput(Axis.X);
-	}
+		P2->Move(Value);
 }
 
 void AMyCar::MoveEnd_P2()
 {
 	if (AMyCar* P2 = GetP2Car(this))
-	{
-		auto* Move = P2->GetVehicleMovementComponent();
-		Move->SetBrakeInput(0.f);
-		Move->SetThrottleInput(0.f);
-		Move->SetSteeringInput(0.f);
-	}
+		P2->MoveEnd();
 }
 
 void AMyCar::OnHandbrakePressed_P2()
 {
 	if (AMyCar* P2 = GetP2Car(this))
-		P2->GetVehicleMovementComponent()->SetHandbrakeInput(true);
+		P2->OnHandbrakePressed();
 }
 
 void AMyCar::OnHandbrakeReleased_P2()
 {
 	if (AMyCar* P2 = GetP2Car(this))
-		P2->GetVehicleMovementComponent()->SetHandbrakeInput(false);
+		P2->OnHandbrakeReleased();
 }
 
 // ---------------------------------------------------------
@@ -254,24 +479,33 @@ void AMyCar::OnHandbrakeReleased_P2()
 void AMyCar::LapCheckpoint(int32 CheckpointNo, int32 MaxCheckpoint, bool bStartFinishLine)
 {
 	bool bNewLap = false;
+	bool bAdvanced = false;
 
 	if (CurrentCheckpointIndex >= MaxCheckpoint && bStartFinishLine)
 	{
 		Lap += 1;
 		CurrentCheckpointIndex = 1;
 		bNewLap = true;
+		bAdvanced = true;
 	}
 	else if (CheckpointNo == CurrentCheckpointIndex + 1)
 	{
 		CurrentCheckpointIndex += 1;
+		bAdvanced = true;
 	}
 	else if (CheckpointNo < CurrentCheckpointIndex)
 	{
 		CurrentCheckpointIndex = CheckpointNo;
 	}
 
-	// ✅ Sync log output and leaderboard behavior
-	UE_LOG(LogTemp, Warning, TEXT("[MyCar] Player %d -> Lap %d | Checkpoint %d"), PlayerID, Lap, CurrentCheckpointIndex);
+	URaceEventBusSubsystem::Emit(this, ERaceEventType::CheckpointCrossed, CurrentCheckpointIndex);
+	if (bNewLap)
+	{
+		URaceEventBusSubsystem::Emit(this, ERaceEventType::LapCompleted, Lap);
+	}
+
+	// notes: every car, every gate; Verbose so the formatting is skipped unless asked for
+	UE_LOG(LogTemp, Verbose, TEXT("[MyCar] Player %d -> Lap %d | Checkpoint %d"), PlayerID, Lap, CurrentCheckpointIndex);
 
 	// --- Global GameState broadcast ---
 	if (ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>())
@@ -282,12 +516,40 @@ void AMyCar::LapCheckpoint(int32 CheckpointNo, int32 MaxCheckpoint, bool bStartF
 			{
 				GS->ResetTimer();
 				GS->bTimerRunning = true;
+				LapStartTime = 0.f;
 			}
 			if (bNewLap)
 			{
 				GS->IncrementLapAndBroadcast();
+
+				// notes: read the clock now; ElapsedTime is shared, stepped, and stops with the race
+				const float RaceTime = GS->GetRaceClock();
+				const float LapTime = RaceTime - LapStartTime;
+				if (LapTime > 0.f)
+				{
+					BestLapTime = (BestLapTime > 0.f) ? FMath::Min(BestLapTime, LapTime) : LapTime;
+				}
+				LapStartTime = RaceTime;
+
+				if (!bFinishedRace && Lap > GS->TotalLaps)
+				{
+					bFinishedRace = true;
+					const URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>();
+					const int32 NumCars = Vehicles ? Vehicles->GetCars().Num() : 1;
+					const int32 Position = GS->RegisterFinish(NumCars);
+					if (URaceResultsSubsystem* Results = URaceResultsSubsystem::Get(this))
+					{
+						Results->SubmitFinish(*this, RaceTime, Position, NumCars);
+					}
+				}
 			}
 		}
+
+		// after a possible race start (ResetTimer clears the pass times)
+		if (bAdvanced)
+		{
+			GS->RecordCheckpointPass(*this);
+		}
 	}
 
 	// --- Local HUD update ---
@@ -295,45 +557,91 @@ void AMyCar::LapCheckpoint(int32 CheckpointNo, int32 MaxCheckpoint, bool bStartF
 	OnLapChangedLocal.Broadcast(Lap, TotalLaps);
 }
 
+void AMyCar::OnRep_LapProgress()
+{
+	// Clients: server already validated; just refresh the local HUD
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	OnLapChangedLocal.Broadcast(Lap, GS ? GS->TotalLaps : 3);
+}
+
 
 // ---------------------------------------------------------
 // PowerUps
 // ---------------------------------------------------------
 void AMyCar::StartSpeedBoost(float DurationSeconds, float Force)
 {
-	if (auto* Move = Cast<UChaosWheeledVehicleMovementComponent>(GetVehicleMovementComponent()))
-	{
-		if (!bBoostActive)
-		{
-			SavedDragCoefficient = Move->DragCoefficient;
-			Move->DragCoefficient = SavedDragCoefficient * BoostDragScale;
-		}
-	}
-
 	BoostForce = (Force > 0.f) ? Force : BoostForce;
 	bBoostActive = true;
 
-	GetWorldTimerManager().ClearTimer(BoostTimer);
-	GetWorldTimerManager().SetTimer(BoostTimer, this, &AMyCar::EndSpeedBoost,
-		(DurationSeconds > 0.f ? DurationSeconds : BoostDurationDefault), false);
+	// Duration is counted in physics time, not by a game-thread timer
+	const float Duration = (DurationSeconds > 0.f ? DurationSeconds : BoostDurationDefault);
+	PendingBoostSeconds.store(Duration);
+	PendingBoostForce.store(BoostForce);
+	BoostRequestSeq.fetch_add(1);
+
+	SetBoostTrail(true);
 
-	UE_LOG(LogTemp, Log, TEXT("[MyCar] BOOST ON for %.2fs, Force=%.0f"), DurationSeconds, BoostForce);
+	URaceEventBusSubsystem::Emit(this, ERaceEventType::BoostStart, 0, Duration);
+	UE_LOG(LogTemp, Verbose, TEXT("[MyCar] BOOST ON for %.2fs, Force=%.0f"), Duration, BoostForce);
 }
 
 void AMyCar::EndSpeedBoost()
 {
-	if (auto* Move = Cast<UChaosWheeledVehicleMovementComponent>(GetVehicleMovementComponent()))
+	// Cancel: zero-length request, physics clears its remaining time next step
+	PendingBoostSeconds.store(0.f);
+	BoostRequestSeq.fetch_add(1);
+
+	bBoostActive = false;
+	SetBoostTrail(false);
+	URaceEventBusSubsystem::Emit(this, ERaceEventType::BoostEnd);
+	UE_LOG(LogTemp, Verbose, TEXT("[MyCar] BOOST OFF"));
+}
+
+void AMyCar::SetBoostTrail(bool bOn)
+{
+	// server; OnRep_BoostTrail does the same on clients
+	bBoostTrail = bOn;
+	UpdateBoostTrail();
+}
+
+void AMyCar::OnRep_BoostTrail()
+{
+	UpdateBoostTrail();
+}
+
+void AMyCar::UpdateBoostTrail()
+{
+	if (!bBoostTrail)
 	{
-		Move->DragCoefficient = SavedDragCoefficient;
+		ReleaseBoostTrail();
+		return;
+	}
+
+	if (!BoostTrailFX)
+	{
+		if (URaceFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<URaceFXPoolSubsystem>())
+		{
+			BoostTrailFX = FXPool->SpawnFX(ERaceFX::BoostTrail, GetActorLocation(), GetActorRotation(), GetMesh());
+		}
 	}
-	bBoostActive = false;
-	UE_LOG(LogTemp, Log, TEXT("[MyCar] BOOST OFF"));
+}
+
+void AMyCar::ReleaseBoostTrail()
+{
+	if (!BoostTrailFX)
+		return;
+
+	if (URaceFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<URaceFXPoolSubsystem>())
+	{
+		FXPool->ReleaseFX(BoostTrailFX, GetMesh());
+	}
+	BoostTrailFX = nullptr;
 }
 
 int32 AMyCar::AddScore(int32 Delta)
 {
 	Score = FMath::Max(0, Score + Delta);
-	UE_LOG(LogTemp, Log, TEXT("[Score] %s += %d => %d"), *GetName(), Delta, Score);
+	UE_LOG(LogTemp, Verbose, TEXT("[Score] %s += %d => %d"), *GetName(), Delta, Score);
 	return Score;
 }
 
@@ -368,6 +676,8 @@ void AMyCar::OnAnyActorHit(AActor* SelfActor, AActor* OtherActor, FVector Normal
 void AMyCar::OnCrashTriggerOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 /*OtherBodyIndex*/, bool /*bFromSweep*/, const FHitResult& /*Sweep*/)
 {
+	RaceCollision::CountOverlapEvent(ERaceOverlapSource::CrashSensor);
+
 	if (bIsGhost || bIsCrashed || !OtherActor || OtherActor == this) return;
 
 	float Speed = 0.f;
@@ -389,13 +699,13 @@ void AMyCar::OnCrashTriggerOverlap(UPrimitiveComponent* OverlappedComp, AActor*
 
 void AMyCar::HandleCarCrash()
 {
-	if (bIsCrashed) return;
+	// Crashes are decided by the server; clients follow via OnRep_IsCrashed
+	if (bIsCrashed || !HasAuthority()) return;
 	bIsCrashed = true;
 
-	if (ExplosionFX)
-	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionFX, GetActorLocation(), GetActorRotation());
-	}
+	URaceEventBusSubsystem::Emit(this, ERaceEventType::Crash);
+
+	PlayCrashFX();
 
 	SetActorHiddenInGame(true);
 	SetActorEnableCollision(false);
@@ -406,45 +716,213 @@ void AMyCar::HandleCarCrash()
 		Move->StopMovementImmediately();
 	}
 
-	FTimerHandle RespawnHandle;
-	GetWorldTimerManager().SetTimer(RespawnHandle, this, &AMyCar::RespawnCar, RespawnDelay, false);
+	GetWorldTimerManager().SetTimer(RespawnTimerHandle, this, &AMyCar::RespawnCar, RespawnDelay, false);
+}
+
+void AMyCar::OnRep_IsCrashed()
+{
+	if (bIsCrashed)
+	{
+		PlayCrashFX();
+	}
+}
+
+void AMyCar::PlayCrashFX()
+{
+	// pool handles dedicated server, per-frame cap and per-viewport culling
+	URaceFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<URaceFXPoolSubsystem>();
+	if (FXPool && FXPool->HasPool(ERaceFX::Explosion))
+	{
+		FXPool->SpawnFX(ERaceFX::Explosion, GetActorLocation(), GetActorRotation());
+	}
+	else if (ExplosionFX && GetNetMode() != NM_DedicatedServer)
+	{
+		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionFX, GetActorLocation(), GetActorRotation());
+	}
 }
 
 void AMyCar::RespawnCar()
 {
 	FVector BaseLoc = InitialSpawnLocation;
 	FRotator BaseRot = InitialSpawnRotation;
+	const int32 Slot = GetRespawnSlot();
 
-	if (LastCheckpoint)
+	// --- Baked respawn slot at the last gate passed; placed checkpoint as fallback ---
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	const URaceTrackData* Track = GS ? GS->GetTrackData() : nullptr;
+	FTransform SlotTransform;
+	if (Track && Track->GetRespawnSlot(Track->FindGateIndex(CurrentCheckpointIndex), Slot, SlotTransform))
 	{
-		BaseLoc = LastCheckpoint->GetActorLocation();
-		BaseRot = LastCheckpoint->GetActorRotation();
+		BaseLoc = SlotTransform.GetLocation();
+		BaseRot = SlotTransform.Rotator();
 	}
+	else
+	{
+		if (LastCheckpoint)
+		{
+			BaseLoc = LastCheckpoint->GetActorLocation();
+			BaseRot = LastCheckpoint->GetActorRotation();
+		}
 
-	BaseLoc.Z += 100.f;
+		BaseLoc.Z += 100.f;
 
-	const int32 Slot = GetRespawnSlot();
-	const FVector Right = BaseRot.RotateVector(FVector::RightVector);
-	BaseLoc += Right * ((Slot - 0.5f) * LaneOffset);
+		const FVector Right = BaseRot.RotateVector(FVector::RightVector);
+		BaseLoc += Right * ((Slot - 0.5f) * LaneOffset);
+	}
 
 	SetActorLocationAndRotation(BaseLoc, BaseRot, false, nullptr, ETeleportType::TeleportPhysics);
 
 	if (USkeletalMeshComponent* CarMesh = GetMesh())
 	{
-		CarMesh->SetPhysicsLinearVelocity(BaseRot.Vector() * ForwardNudgeOnRespawn);
 		CarMesh->WakeAllRigidBodies();
 	}
 
+	// Nudge is applied on the next physics step, after the teleport has landed
+	PendingRespawnNudge.store(ForwardNudgeOnRespawn);
+	NudgeRequestSeq.fetch_add(1);
+
 	SetActorHiddenInGame(false);
 	SetActorEnableCollision(true);
 	SetActorTickEnabled(true);
 
 	BeginGhost();
 	bIsCrashed = false;
+	ClearTrackLimitState();
+	LineDriverSegment = INDEX_NONE;
+	LineDriverStuckTime = 0.f;
+
+	URaceEventBusSubsystem::Emit(this, ERaceEventType::Respawn);
 
 	UE_LOG(LogTemp, Warning, TEXT("[Crash] Respawned safely at %s"), *BaseLoc.ToString());
 }
 
+void AMyCar::ResetRaceProgress()
+{
+	// pending respawn / ghost / boost timers belong to the old episode
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	EndGhost();
+	if (bBoostActive)
+	{
+		EndSpeedBoost();
+	}
+	SetSimLOD(ERaceSimLOD::Full);
+	SetDriveInput(FRaceDriveInput());
+
+	SetActorLocationAndRotation(InitialSpawnLocation, InitialSpawnRotation, false, nullptr, ETeleportType::ResetPhysics);
+	if (USkeletalMeshComponent* CarMesh = GetMesh())
+	{
+		CarMesh->SetAllPhysicsLinearVelocity(FVector::ZeroVector);
+		CarMesh->SetAllPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+		CarMesh->WakeAllRigidBodies();
+	}
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	bIsCrashed = false;
+	Lap = 1;
+	CurrentCheckpointIndex = 0;
+	LastCheckpoint = nullptr;
+	LocalElapsedTime = 0.f;
+	if (const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>())
+	{
+		LocalStartTime = GS->GetDisplayElapsedTime();
+	}
+	GapToLeader = 0.f;
+	IntervalToAhead = 0.f;
+	BestLapTime = 0.f;
+	LapStartTime = 0.f;
+	bFinishedRace = false;
+	TrackLimitCuts = 0;
+	ClearTrackLimitState();
+	LineDriverSegment = INDEX_NONE;
+	LineDriverStuckTime = 0.f;
+}
+
+// ---------------------------------------------------------
+// Track limits
+// notes: a cut is judged when the car rejoins: lap distance gained while off
+//        track minus the distance actually driven there. Running wide gains
+//        about what it drives; straight across a chicane gains much more.
+// ---------------------------------------------------------
+void AMyCar::UpdateTrackLimits(float SignedDistance, float StepSeconds)
+{
+	const URaceSettings* Settings = URaceSettings::Get();
+	const bool bNowOffTrack = SignedDistance > Settings->TrackLimitsTolerance;
+
+	if (bNowOffTrack != bOffTrack)
+	{
+		const float LapDistance = GetLapDistance();
+		if (bNowOffTrack)
+		{
+			OffTrackTime = 0.f;
+			OffTrackDriven = 0.f;
+			OffTrackLapDistance = LapDistance;
+		}
+		else
+		{
+			const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+			const float Length = GS ? GS->GetTrackLine().GetLength() : 0.f;
+			float Gained = LapDistance - OffTrackLapDistance;
+			if (Length > 0.f)
+			{
+				Gained = FMath::Wrap(Gained, -0.5f * Length, 0.5f * Length);
+			}
+
+			const float Excess = Gained - OffTrackDriven;
+			if (Excess > Settings->TrackLimitsCutTolerance)
+			{
+				++TrackLimitCuts;
+				URaceEventBusSubsystem::Emit(this, ERaceEventType::TrackCut, TrackLimitCuts, Excess);
+				UE_LOG(LogTemp, Log, TEXT("[TrackLimits] Player %d cut the track: +%.0f cm over %.0f cm driven (%d cuts)"),
+					PlayerID, Gained, OffTrackDriven, TrackLimitCuts);
+			}
+		}
+
+		bOffTrack = bNowOffTrack;
+		URaceEventBusSubsystem::Emit(this, ERaceEventType::OffTrack, bOffTrack ? 1 : 0, bOffTrack ? 0.f : OffTrackTime);
+	}
+
+	if (!bOffTrack)
+	{
+		return;
+	}
+
+	OffTrackTime += StepSeconds;
+	OffTrackDriven += GetVelocity().Size2D() * StepSeconds;
+
+	if (Settings->bTrackLimitsAutoRespawn && OffTrackTime >= Settings->TrackLimitsRespawnSeconds)
+	{
+		GetWorldTimerManager().ClearTimer(RespawnTimerHandle);
+		RespawnCar();
+	}
+}
+
+float AMyCar::GetLapDistance() const
+{
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	const URaceTrackData* Track = GS ? GS->GetTrackData() : nullptr;
+	if (!Track || !Track->TrackLine.IsValid())
+	{
+		return 0.f;
+	}
+
+	// centreline points are the gates, so the last gate passed is the segment the car is on
+	const int32 Gate = Track->FindGateIndex(CurrentCheckpointIndex);
+	return Gate != INDEX_NONE
+		? Track->TrackLine.ProjectNear(GetActorLocation(), Gate, /*SearchRadius*/2)
+		: Track->TrackLine.Project(GetActorLocation());
+}
+
+void AMyCar::ClearTrackLimitState()
+{
+	bOffTrack = false;
+	OffTrackTime = 0.f;
+	OffTrackDriven = 0.f;
+	OffTrackLapDistance = 0.f;
+}
+
 // ---------------------------------------------------------
 // Respawn helpers
 // ---------------------------------------------------------
@@ -470,7 +948,9 @@ bool AMyCar::FindSafeRespawnSpot(const FVector& BaseLoc, const FRotator& BaseRot
 		return false;
 	}
 
-	TArray<FVector> Offsets;
+	// notes: 3 candidates per search step; inline for the default MaxRespawnSearchSteps
+	TArray<FVector, TInlineAllocator<24>> Offsets;
+	Offsets.Reserve(MaxRespawnSearchSteps * 3);
 	const FVector Fwd = BaseRot.RotateVector(FVector::ForwardVector);
 	const FVector Right = BaseRot.RotateVector(FVector::RightVector);
 
@@ -524,18 +1004,21 @@ void AMyCar::BeginGhost()
 	if (USkeletalMeshComponent* CarMesh = GetMesh())
 	{
 		CarMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		CarMesh->SetCollisionResponseToChannel(ECC_RaceCar, ECR_Ignore);
 	}
 
-	TArray<AActor*> Cars;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMyCar::StaticClass(), Cars);
-	for (AActor* A : Cars)
+	// notes: registry instead of an actor iterator + temporary array
+	const URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>();
+	if (Vehicles && GetMesh())
 	{
-		if (A && A != this && GetMesh())
-			GetMesh()->IgnoreActorWhenMoving(A, true);
+		for (AMyCar* Other : Vehicles->GetCars())
+		{
+			if (Other && Other != this)
+				GetMesh()->IgnoreActorWhenMoving(Other, true);
+		}
 	}
 
-	FTimerHandle GhostHandle;
-	GetWorldTimerManager().SetTimer(GhostHandle, this, &AMyCar::EndGhost, GhostTimeAfterRespawn, false);
+	GetWorldTimerManager().SetTimer(GhostTimerHandle, this, &AMyCar::EndGhost, GhostTimeAfterRespawn, false);
 }
 
 void AMyCar::EndGhost()
@@ -546,15 +1029,166 @@ void AMyCar::EndGhost()
 	if (USkeletalMeshComponent* CarMesh = GetMesh())
 	{
 		CarMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+		CarMesh->SetCollisionResponseToChannel(ECC_RaceCar, ECR_Block);
 
-		TArray<AActor*> Cars;
-		UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMyCar::StaticClass(), Cars);
-		for (AActor* A : Cars)
+		if (const URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>())
 		{
-			if (A && A != this)
-				CarMesh->IgnoreActorWhenMoving(A, false);
+			for (AMyCar* Other : Vehicles->GetCars())
+			{
+				if (Other && Other != this)
+					CarMesh->IgnoreActorWhenMoving(Other, false);
+			}
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[Respawn] Ghost ended."));
-}
\ No newline at end of file
+	UE_LOG(LogTemp, Verbose, TEXT("[Respawn] Ghost ended."));
+}
+
+
+// ---------------------------------------------------------
+// Simulation LOD
+// ---------------------------------------------------------
+bool AMyCar::CanUseProxySim() const
+{
+	if (IsPlayerControlled() || bIsCrashed)
+		return false;
+
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	return GS && GS->GetTrackLine().IsValid();
+}
+
+void AMyCar::SetSimLOD(ERaceSimLOD NewLOD)
+{
+	if (NewLOD == SimLOD)
+		return;
+
+	const ERaceSimLOD OldLOD = SimLOD;
+	SimLOD = NewLOD;
+
+	if (OldLOD == ERaceSimLOD::Proxy)
+	{
+		ExitProxySim();
+	}
+
+	switch (NewLOD)
+	{
+	case ERaceSimLOD::Full:
+		ApplyTickInterval(0.f);
+		break;
+	case ERaceSimLOD::Reduced:
+		// game-thread tick only; the physics-thread vehicle sim is unchanged
+		ApplyTickInterval(URaceSettings::Get()->ReducedTickInterval);
+		break;
+	case ERaceSimLOD::Proxy:
+		ApplyTickInterval(0.f); // proxy moves every frame, it's just cheap
+		EnterProxySim();
+		break;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("[SimLOD] %s -> %s"), *GetName(), *UEnum::GetValueAsString(NewLOD));
+}
+
+void AMyCar::ApplyTickInterval(float Interval)
+{
+	SetActorTickInterval(Interval);
+
+	// notes: mesh / AnimBP rate is presentation, owned by ApplySignificance
+	if (UChaosVehicleMovementComponent* Move = GetVehicleMovementComponent())
+	{
+		Move->SetComponentTickInterval(Interval);
+	}
+}
+
+void AMyCar::ApplySignificance(ERaceSignificance NewSignificance)
+{
+	if (NewSignificance == Significance)
+		return;
+	Significance = NewSignificance;
+
+	USkeletalMeshComponent* CarMesh = GetMesh();
+	if (!CarMesh)
+		return;
+
+	// wheel AnimBP follows the mesh tick; hidden in every view -> only pose when rendered
+	CarMesh->SetComponentTickInterval(URaceSignificanceSubsystem::GetTickIntervalFor(NewSignificance));
+	CarMesh->VisibilityBasedAnimTickOption = (NewSignificance == ERaceSignificance::Hidden)
+		? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered
+		: EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	CarMesh->SetCastShadow(NewSignificance == ERaceSignificance::High || NewSignificance == ERaceSignificance::Medium);
+}
+
+void AMyCar::EnterProxySim()
+{
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	if (!GS)
+		return;
+
+	const FRaceTrackLine& Line = GS->GetGuideLine();
+	const FVector Loc = GetActorLocation();
+
+	// --- Remember where we are relative to the line so the hand-off is seamless ---
+	ProxyDistance = Line.Project(Loc);
+	FVector LineLoc, LineDir;
+	Line.Sample(ProxyDistance, LineLoc, LineDir);
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, LineDir).GetSafeNormal();
+	const FVector Delta = Loc - LineLoc;
+	ProxyOffset = FVector2D(FVector::DotProduct(Delta, Right), Delta.Z);
+	ProxySpeed = FMath::Max(GetVelocity().Size(), ProxyMinSpeed);
+
+	if (USkeletalMeshComponent* CarMesh = GetMesh())
+	{
+		CarMesh->SetSimulatePhysics(false);
+		CarMesh->SetComponentTickEnabled(false);
+	}
+	if (UChaosVehicleMovementComponent* Move = GetVehicleMovementComponent())
+	{
+		Move->Deactivate();
+	}
+}
+
+void AMyCar::ExitProxySim()
+{
+	FVector Dir = GetActorForwardVector();
+	if (const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>())
+	{
+		FVector LineLoc;
+		GS->GetGuideLine().Sample(ProxyDistance, LineLoc, Dir);
+	}
+
+	if (USkeletalMeshComponent* CarMesh = GetMesh())
+	{
+		CarMesh->SetComponentTickEnabled(true);
+		CarMesh->SetSimulatePhysics(true);
+		CarMesh->SetPhysicsLinearVelocity(Dir * ProxySpeed);
+	}
+	if (UChaosVehicleMovementComponent* Move = GetVehicleMovementComponent())
+	{
+		Move->Activate(true);
+	}
+}
+
+void AMyCar::TickProxySim(float DeltaSeconds)
+{
+	const ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+	if (!GS)
+		return;
+
+	// baked racing line: drift onto it and chase its speed targets (eased, so the hand-off doesn't snap)
+	if (const URaceLineData* RacingLine = GS->GetRacingLine())
+	{
+		ProxySpeed = FMath::FInterpTo(ProxySpeed, FMath::Max(RacingLine->GetTargetSpeed(ProxyDistance), ProxyMinSpeed), DeltaSeconds, 1.f);
+		ProxyOffset.X = FMath::FInterpTo(ProxyOffset.X, 0.f, DeltaSeconds, 0.5f);
+	}
+
+	const FRaceTrackLine& Line = GS->GetGuideLine();
+	ProxyDistance = Line.WrapDistance(ProxyDistance + ProxySpeed * DeltaSeconds);
+
+	FVector LineLoc, LineDir;
+	Line.Sample(ProxyDistance, LineLoc, LineDir);
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, LineDir).GetSafeNormal();
+	const FVector NewLoc = LineLoc + Right * ProxyOffset.X + FVector::UpVector * ProxyOffset.Y;
+
+	// no sweep: overlaps still update, so checkpoints keep counting proxy laps
+	SetActorLocationAndRotation(NewLoc, LineDir.Rotation(), false, nullptr, ETeleportType::TeleportPhysics);
+}
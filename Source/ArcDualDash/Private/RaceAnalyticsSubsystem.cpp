@@ -0,0 +1,280 @@
+// ============================================================================
+// RaceAnalyticsSubsystem.cpp
+// notes: ranking order is the one UpdateLeaderboard always used
+//        (lap -> checkpoint -> distance to next gate), so the leaderboard and
+//        its replication behave as before; only where and when it runs moved.
+// ============================================================================
+#include "RaceAnalyticsSubsystem.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
+#include "RaceVehicleSubsystem.h"
+
+#include "Engine/World.h"
+
+bool URaceAnalyticsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+URaceAnalyticsSubsystem* URaceAnalyticsSubsystem::Get(const UObject* WorldContext)
+{
+    const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<URaceAnalyticsSubsystem>() : nullptr;
+}
+
+void URaceAnalyticsSubsystem::Deinitialize()
+{
+    // notes: the task writes into this object
+    Task.Wait();
+    TaskIndex = INDEX_NONE;
+
+    Super::Deinitialize();
+}
+
+ARaceGameState* URaceAnalyticsSubsystem::GetAuthorityGameState()
+{
+    ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+    return GS && GS->HasAuthority() && CacheTrack(*GS) ? GS : nullptr;
+}
+
+bool URaceAnalyticsSubsystem::CacheTrack(const ARaceGameState& GS)
+{
+    if (Track.GateDistances.Num() > 0)
+    {
+        return true;
+    }
+
+    const URaceTrackData* TrackData = GS.GetTrackData();
+    if (!TrackData || TrackData->Gates.Num() == 0)
+    {
+        return false;
+    }
+
+    LLM_SCOPE_BYTAG(Race_Leaderboard);
+
+    Track.GateDistances.Reset(TrackData->Gates.Num());
+    for (const FRaceTrackGate& Gate : TrackData->Gates)
+    {
+        Track.GateDistances.Add(Gate.Distance);
+    }
+    Track.Length = TrackData->TrackLine.GetLength();
+    return true;
+}
+
+// ============================================================================
+// Game thread
+// ============================================================================
+void URaceAnalyticsSubsystem::PublishSnapshot(uint64 StepCount)
+{
+    ARaceGameState* GS = GetAuthorityGameState();
+    if (!GS)
+    {
+        return;
+    }
+
+    ApplyFinishedPass();
+
+    const int32 Written = CaptureSnapshot(*GS, StepCount);
+
+    // --- launch the next pass when due and the previous one has been consumed ---
+    const URaceSettings* Settings = URaceSettings::Get();
+    const uint64 PassSteps = (uint64)FMath::Max(1, FMath::RoundToInt(Settings->LeaderboardInterval * Settings->RaceLogicHz));
+    if (TaskIndex != INDEX_NONE || StepCount - LastPassStep < PassSteps)
+    {
+        return;
+    }
+
+    LastPassStep = StepCount;
+    TaskIndex = Written;
+    Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Written]()
+    {
+        LLM_SCOPE_BYTAG(Race_Leaderboard);
+        Compute(Snapshots[Written], Track, PreviousPositions, NumPositionChanges, Result);
+    });
+}
+
+void URaceAnalyticsSubsystem::Flush()
+{
+    ARaceGameState* GS = GetAuthorityGameState();
+    if (!GS)
+    {
+        return;
+    }
+
+    Task.Wait();
+    ApplyFinishedPass();
+
+    const int32 Written = CaptureSnapshot(*GS, Snapshots[LatestIndex].StepCount);
+    {
+        LLM_SCOPE_BYTAG(Race_Leaderboard);
+        Compute(Snapshots[Written], Track, PreviousPositions, NumPositionChanges, Result);
+    }
+    GS->ApplyRaceAnalytics(Result);
+}
+
+int32 URaceAnalyticsSubsystem::CaptureSnapshot(const ARaceGameState& GS, uint64 StepCount)
+{
+    LLM_SCOPE_BYTAG(Race_Leaderboard);
+
+    // notes: never the buffer the task is reading
+    int32 Write = LatestIndex ^ 1;
+    if (Write == TaskIndex)
+    {
+        Write = LatestIndex;
+    }
+
+    FRaceSnapshot& Snapshot = Snapshots[Write];
+    Snapshot.StepCount = StepCount;
+    Snapshot.RaceTime = GS.ElapsedTime;
+    Snapshot.Cars.Reset();
+
+    LatestIndex = Write;
+
+    const URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>();
+    if (!Vehicles)
+    {
+        return Write;
+    }
+
+    const TArray<FRaceTrackGate>& Gates = GS.GetTrackData()->Gates;
+    const int32 NumGates = Gates.Num();
+
+    for (AMyCar* Car : Vehicles->GetCars())
+    {
+        if (!IsValid(Car))
+        {
+            continue;
+        }
+
+        const FTransform& Transform = Car->GetActorTransform();
+
+        FRaceCarSnapshot& Out = Snapshot.Cars.AddDefaulted_GetRef();
+        Out.Car = Car;
+        Out.PlayerID = Car->PlayerID;
+        Out.Location = FVector3f(Transform.GetLocation());
+        Out.Rotation = FQuat4f(Transform.GetRotation());
+        Out.Velocity = FVector3f(Car->GetVelocity());
+        Out.Lap = Car->Lap;
+        Out.Checkpoint = Car->CurrentCheckpointIndex;
+
+        // --- same next-gate distance the leaderboard always ranked on ---
+        Out.DistanceToNext = 999999.f;
+        if (Gates.IsValidIndex(Out.Checkpoint))
+        {
+            const int32 NextIdx = (Out.Checkpoint % NumGates + 1) % NumGates;
+            Out.DistanceToNext = FVector::Dist(Transform.GetLocation(), Gates[NextIdx].Location);
+        }
+    }
+    return Write;
+}
+
+void URaceAnalyticsSubsystem::ApplyFinishedPass()
+{
+    if (TaskIndex == INDEX_NONE || !Task.IsCompleted())
+    {
+        return;
+    }
+    TaskIndex = INDEX_NONE;
+
+    if (ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>())
+    {
+        GS->ApplyRaceAnalytics(Result);
+    }
+}
+
+// ============================================================================
+// Worker: ranking, race distance, position changes, stats
+// ============================================================================
+void URaceAnalyticsSubsystem::Compute(const FRaceSnapshot& Snapshot, const FTrackInfo& Track,
+    TMap<TWeakObjectPtr<AMyCar>, int32>& PreviousPositions, int32& NumPositionChanges, FRaceAnalytics& Out)
+{
+    Out.StepCount = Snapshot.StepCount;
+    Out.Standings.Reset(Snapshot.Cars.Num());
+    Out.PositionChanges.Reset(Snapshot.Cars.Num());     // worst case; grows only when the field does
+    Out.Stats = FRaceStats();
+
+    const int32 NumGates = Track.GateDistances.Num();
+
+    for (const FRaceCarSnapshot& Car : Snapshot.Cars)
+    {
+        FRaceStanding& Standing = Out.Standings.AddDefaulted_GetRef();
+        Standing.Car = Car.Car;
+        Standing.Lap = Car.Lap;
+        Standing.Checkpoint = Car.Checkpoint;
+        Standing.DistanceToNext = Car.DistanceToNext;
+
+        // --- race distance: laps done + distance to the next gate along the line ---
+        if (NumGates > 0 && Track.Length > 0.f)
+        {
+            const int32 NextIdx = (Car.Checkpoint + 1) % NumGates;
+            const float GateDistance = NextIdx == 0 ? Track.Length : Track.GateDistances[NextIdx];
+            Standing.Progress = (Car.Lap - 1) * Track.Length + GateDistance - FMath::Min(Car.DistanceToNext, GateDistance);
+        }
+
+        const float Speed = Car.Velocity.Size();
+        Out.Stats.AverageSpeed += Speed;
+        if (Speed > Out.Stats.TopSpeed)
+        {
+            Out.Stats.TopSpeed = Speed;
+            Out.Stats.TopSpeedPlayerID = Car.PlayerID;
+        }
+    }
+
+    if (Out.Standings.Num() == 0)
+    {
+        PreviousPositions.Reset();
+        return;
+    }
+    Out.Stats.AverageSpeed /= Out.Standings.Num();
+
+    // --- rank ---
+    Out.Standings.Sort([](const FRaceStanding& A, const FRaceStanding& B)
+        {
+            if (A.Lap != B.Lap)
+                return A.Lap > B.Lap;
+            if (A.Checkpoint != B.Checkpoint)
+                return A.Checkpoint > B.Checkpoint;
+            return A.DistanceToNext < B.DistanceToNext;
+        });
+
+    const float LeaderProgress = Out.Standings[0].Progress;
+    Out.Stats.FieldSpread = FMath::Max(0.f, LeaderProgress - Out.Standings.Last().Progress);
+
+    // --- position changes against the previous pass (new cars are not a change) ---
+    // notes: updated in place; the map only allocates when a car joins
+    for (int32 i = 0; i < Out.Standings.Num(); ++i)
+    {
+        const TWeakObjectPtr<AMyCar>& Car = Out.Standings[i].Car;
+        const int32 Position = i + 1;
+        if (int32* Previous = PreviousPositions.Find(Car))
+        {
+            if (*Previous != Position)
+            {
+                Out.PositionChanges.Add({ Car, *Previous, Position });
+                *Previous = Position;
+            }
+        }
+        else
+        {
+            PreviousPositions.Add(Car, Position);
+        }
+    }
+
+    // --- cars that left the race ---
+    if (PreviousPositions.Num() > Out.Standings.Num())
+    {
+        for (auto It = PreviousPositions.CreateIterator(); It; ++It)
+        {
+            const TWeakObjectPtr<AMyCar>& Car = It.Key();
+            if (!Out.Standings.ContainsByPredicate([&Car](const FRaceStanding& Standing) { return Standing.Car == Car; }))
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    NumPositionChanges += Out.PositionChanges.Num();
+    Out.Stats.NumPositionChanges = NumPositionChanges;
+}
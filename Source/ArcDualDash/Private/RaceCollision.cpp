@@ -0,0 +1,105 @@
+// ============================================================================
+// RaceCollision.cpp
+// notes: pair entries come from each component's overlap list; a pair between
+//        two overlap-generating components is listed on both, so the unique
+//        count is about half the entries.
+// ============================================================================
+#include "RaceCollision.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+namespace RaceCollision
+{
+    static uint64 GEventCounts[(int32)ERaceOverlapSource::MAX] = {};
+    static uint64 GReportedCounts[(int32)ERaceOverlapSource::MAX] = {};
+    static uint64 GReportedFrame = 0;
+
+    static const TCHAR* GetSourceName(ERaceOverlapSource Source)
+    {
+        switch (Source)
+        {
+        case ERaceOverlapSource::Gate:        return TEXT("Gate");
+        case ERaceOverlapSource::Pickup:      return TEXT("Pickup");
+        case ERaceOverlapSource::CrashSensor: return TEXT("CrashSensor");
+        default:                              return TEXT("?");
+        }
+    }
+
+    void CountOverlapEvent(ERaceOverlapSource Source)
+    {
+        ++GEventCounts[(int32)Source];
+    }
+
+    void PrintOverlapStats(UWorld* World, FOutputDevice& Ar)
+    {
+        if (!World)
+        {
+            return;
+        }
+
+        struct FRow
+        {
+            int32 Components = 0;
+            int32 PairEntries = 0;
+        };
+        TMap<FName, FRow> Rows;
+        int32 TotalComponents = 0;
+        int32 TotalEntries = 0;
+
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            It->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors*/false, [&](UPrimitiveComponent* Primitive)
+            {
+                if (!Primitive->GetGenerateOverlapEvents() || !Primitive->IsCollisionEnabled())
+                {
+                    return;
+                }
+                FRow& Row = Rows.FindOrAdd(Primitive->GetCollisionProfileName());
+                ++Row.Components;
+                Row.PairEntries += Primitive->GetOverlapInfos().Num();
+                ++TotalComponents;
+                TotalEntries += Primitive->GetOverlapInfos().Num();
+            });
+        }
+
+        Rows.ValueSort([](const FRow& A, const FRow& B) { return A.PairEntries > B.PairEntries; });
+
+        Ar.Log(TEXT("[Overlap] ---- overlap-generating primitives ----"));
+        Ar.Logf(TEXT("[Overlap] %-20s %10s %12s"), TEXT("Profile"), TEXT("Components"), TEXT("Pair entries"));
+        for (const TPair<FName, FRow>& Pair : Rows)
+        {
+            Ar.Logf(TEXT("[Overlap] %-20s %10d %12d"), *Pair.Key.ToString(), Pair.Value.Components, Pair.Value.PairEntries);
+        }
+        Ar.Logf(TEXT("[Overlap] %d components, %d pair entries (~%d pairs)"), TotalComponents, TotalEntries, (TotalEntries + 1) / 2);
+
+        // --- handler events per frame since the last report ---
+        const uint64 Frames = GReportedFrame > 0 ? FMath::Max<uint64>(GFrameCounter - GReportedFrame, 1) : 0;
+        for (int32 i = 0; i < (int32)ERaceOverlapSource::MAX; ++i)
+        {
+            const uint64 Events = GEventCounts[i] - GReportedCounts[i];
+            if (Frames > 0)
+            {
+                Ar.Logf(TEXT("[Overlap] %-12s %llu events over %llu frames (%.2f / frame)"),
+                    GetSourceName((ERaceOverlapSource)i), Events, Frames, (double)Events / Frames);
+            }
+            GReportedCounts[i] = GEventCounts[i];
+        }
+        if (Frames == 0)
+        {
+            Ar.Log(TEXT("[Overlap] event rates start now; run race.OverlapStats again later"));
+        }
+        GReportedFrame = GFrameCounter;
+    }
+}
+
+static FAutoConsoleCommandWithWorld GRaceOverlapStatsCommand(
+    TEXT("race.OverlapStats"),
+    TEXT("Print overlap pairs per collision profile and race overlap events per frame since the previous call."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+        RaceCollision::PrintOverlapStats(World, *GLog);
+    }));
@@ -0,0 +1,215 @@
+// ============================================================================
+// RaceEventBus.cpp
+// notes: the ring is drained in the subsystem tick (after actor ticks), so a
+//        frame's events reach consumers the same frame. A batch is shared
+//        read-only between worker tasks; it is freed with the last task.
+// ============================================================================
+#include "RaceEventBus.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceSettings.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarRaceLogEvents(
+    TEXT("race.LogEvents"),
+    0,
+    TEXT("Log every race event from the event bus logging consumer (worker thread)."),
+    ECVF_Default);
+
+static const TCHAR* GetEventName(ERaceEventType Type)
+{
+    switch (Type)
+    {
+    case ERaceEventType::CheckpointCrossed: return TEXT("Checkpoint");
+    case ERaceEventType::LapCompleted:      return TEXT("Lap");
+    case ERaceEventType::Pickup:            return TEXT("Pickup");
+    case ERaceEventType::Crash:             return TEXT("Crash");
+    case ERaceEventType::Respawn:           return TEXT("Respawn");
+    case ERaceEventType::BoostStart:        return TEXT("BoostStart");
+    case ERaceEventType::BoostEnd:          return TEXT("BoostEnd");
+    case ERaceEventType::OffTrack:          return TEXT("OffTrack");
+    case ERaceEventType::TrackCut:          return TEXT("TrackCut");
+    default:                                return TEXT("?");
+    }
+}
+
+static FAutoConsoleCommandWithWorld GRaceEventStatsCommand(
+    TEXT("race.EventStats"),
+    TEXT("Print race event bus counters for this world."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+        if (const URaceEventBusSubsystem* Bus = World ? World->GetSubsystem<URaceEventBusSubsystem>() : nullptr)
+        {
+            Bus->PrintStats();
+        }
+    }));
+
+bool URaceEventBusSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URaceEventBusSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URaceEventBusSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+void URaceEventBusSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    Super::Initialize(Collection);
+
+    Ring.Init(URaceSettings::Get()->EventBusCapacity);
+
+    // --- built-in worker consumers ---
+    StatsHandle = AddConsumer(ERaceEventThread::Worker, [this](TConstArrayView<FRaceEvent> Events)
+    {
+        for (const FRaceEvent& Event : Events)
+        {
+            EventCounts[(int32)Event.Type].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    LogHandle = AddConsumer(ERaceEventThread::Worker, [](TConstArrayView<FRaceEvent> Events)
+    {
+        if (CVarRaceLogEvents.GetValueOnAnyThread() == 0)
+        {
+            return;
+        }
+        for (const FRaceEvent& Event : Events)
+        {
+            UE_LOG(LogTemp, Log, TEXT("[RaceEvent] t=%.2f Player %d %s value=%d amount=%.2f at %s"),
+                Event.Time, Event.PlayerID, GetEventName(Event.Type), Event.Value, Event.Amount, *Event.Location.ToString());
+        }
+    });
+}
+
+void URaceEventBusSubsystem::Deinitialize()
+{
+    // notes: consumers capture this subsystem; nothing may still be running
+    for (FConsumerEntry& Entry : Consumers)
+    {
+        Entry.LastTask.Wait();
+    }
+    Consumers.Reset();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// Producers
+// ============================================================================
+void URaceEventBusSubsystem::Emit(const AMyCar* Car, ERaceEventType Type, int32 Value, float Amount)
+{
+    const UWorld* World = Car ? Car->GetWorld() : nullptr;
+    URaceEventBusSubsystem* Bus = World ? World->GetSubsystem<URaceEventBusSubsystem>() : nullptr;
+    if (!Bus)
+    {
+        return;
+    }
+
+    FRaceEvent Event;
+    Event.Type = Type;
+    Event.PlayerID = Car->PlayerID;
+    Event.Value = Value;
+    Event.Amount = Amount;
+    Event.Time = World->GetTimeSeconds();
+    Event.Location = FVector3f(Car->GetActorLocation());
+    Event.CarIndex = Car->GetUniqueID();
+    Bus->Push(Event);
+}
+
+void URaceEventBusSubsystem::Push(const FRaceEvent& Event)
+{
+    if (!Ring.Push(Event))
+    {
+        NumDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// Consumers
+// ============================================================================
+int32 URaceEventBusSubsystem::AddConsumer(ERaceEventThread Thread, FRaceEventConsumer Consumer)
+{
+    check(IsInGameThread());
+
+    FConsumerEntry& Entry = Consumers.AddDefaulted_GetRef();
+    Entry.Handle = NextHandle++;
+    Entry.Thread = Thread;
+    Entry.Fn = MakeShared<FRaceEventConsumer>(MoveTemp(Consumer));
+    return Entry.Handle;
+}
+
+void URaceEventBusSubsystem::RemoveConsumer(int32 Handle)
+{
+    check(IsInGameThread());
+
+    const int32 Index = Consumers.IndexOfByPredicate([Handle](const FConsumerEntry& E) { return E.Handle == Handle; });
+    if (Index != INDEX_NONE)
+    {
+        // notes: the caller may free whatever the consumer captured right after this returns
+        Consumers[Index].LastTask.Wait();
+        Consumers.RemoveAt(Index);
+    }
+}
+
+void URaceEventBusSubsystem::Tick(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    TSharedPtr<TArray<FRaceEvent>> Batch;
+    FRaceEvent Event;
+    while (Ring.Pop(Event))
+    {
+        if (!Batch)
+        {
+            Batch = MakeShared<TArray<FRaceEvent>>();
+        }
+        Batch->Add(Event);
+    }
+    if (!Batch)
+    {
+        return;
+    }
+
+    for (FConsumerEntry& Entry : Consumers)
+    {
+        if (Entry.Thread == ERaceEventThread::GameThread)
+        {
+            (*Entry.Fn)(*Batch);
+            continue;
+        }
+
+        // notes: previous task as prerequisite -> one batch at a time, in order, per consumer
+        TSharedPtr<const TArray<FRaceEvent>> SharedBatch = Batch;
+        Entry.LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+            [Fn = Entry.Fn, SharedBatch]() { (*Fn)(*SharedBatch); },
+            UE::Tasks::Prerequisites(Entry.LastTask));
+    }
+
+    if (OnRaceEvent.IsBound())
+    {
+        for (const FRaceEvent& E : *Batch)
+        {
+            OnRaceEvent.Broadcast(E);
+        }
+    }
+}
+
+void URaceEventBusSubsystem::PrintStats() const
+{
+    UE_LOG(LogTemp, Log, TEXT("[RaceEvent] ---- event bus: %d consumers, %llu dropped ----"),
+        Consumers.Num(), GetNumDropped());
+    for (int32 i = 0; i < (int32)ERaceEventType::MAX; ++i)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[RaceEvent] %-12s %llu"),
+            GetEventName((ERaceEventType)i), EventCounts[i].load(std::memory_order_relaxed));
+    }
+}
@@ -0,0 +1,234 @@
+// ============================================================================
+// RaceFXPoolSubsystem.cpp
+// notes: components are owned by the WorldSettings actor so they live exactly
+//        as long as the world; nothing is created or destroyed mid-race.
+// ============================================================================
+#include "RaceFXPoolSubsystem.h"
+#include "RaceMemory.h"
+#include "RaceSettings.h"
+#include "RaceSignificanceSubsystem.h"
+#include "RaceVehicleSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+
+bool URaceFXPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================================
+// Pre-warm
+// ============================================================================
+void URaceFXPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // notes: nobody sees FX on a dedicated server
+    if (InWorld.GetNetMode() == NM_DedicatedServer)
+    {
+        return;
+    }
+
+    const URaceSettings* Settings = URaceSettings::Get();
+    PrewarmPool(ERaceFX::Explosion, Settings->ExplosionFX, Settings->ExplosionPoolSize);
+    PrewarmPool(ERaceFX::BoostTrail, Settings->BoostTrailFX, Settings->BoostTrailPoolSize);
+    PrewarmPool(ERaceFX::Pickup, Settings->PickupFX, Settings->PickupPoolSize);
+}
+
+void URaceFXPoolSubsystem::PrewarmPool(ERaceFX Type, const TSoftObjectPtr<UNiagaraSystem>& SystemRef, int32 Size)
+{
+    LLM_SCOPE_BYTAG(Race_Vehicles);
+
+    FRaceFXPool& Pool = Pools[(int32)Type];
+    Pool.Components.Reset();
+    Pool.Holders.Reset();
+    Pool.Next = 0;
+
+    // notes: normally already resident through the RacePreload bundle; sync load is the fallback
+    UNiagaraSystem* System = SystemRef.LoadSynchronous();
+    if (!System)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[FXPool] No Niagara system set for %s (Project Settings -> Race)"),
+            *UEnum::GetValueAsString(Type));
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    AActor* Owner = World->GetWorldSettings();
+    URaceSignificanceSubsystem* SignificanceSys = World->GetSubsystem<URaceSignificanceSubsystem>();
+
+    for (int32 i = 0; i < Size; ++i)
+    {
+        UNiagaraComponent* Comp = NewObject<UNiagaraComponent>(Owner);
+        Comp->SetAsset(System);
+        Comp->SetAutoActivate(false);
+        Comp->SetAutoDestroy(false);
+        Comp->RegisterComponentWithWorld(World);
+
+        // warm: one activation builds the instance / GPU data up front
+        Comp->Activate(true);
+        Comp->DeactivateImmediate();
+
+        if (SignificanceSys)
+        {
+            SignificanceSys->RegisterEmitter(Comp);
+        }
+        Pool.Components.Add(Comp);
+    }
+    Pool.Holders.SetNum(Pool.Components.Num());
+
+    UE_LOG(LogTemp, Log, TEXT("[FXPool] Pre-warmed %d x %s"), Size, *System->GetName());
+}
+
+void URaceFXPoolSubsystem::Deinitialize()
+{
+    for (FRaceFXPool& Pool : Pools)
+    {
+        Pool.Components.Reset();
+        Pool.Holders.Reset();
+    }
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// Spawn / release
+// ============================================================================
+bool URaceFXPoolSubsystem::PassesCulling(ERaceFX Type, const FVector& Location) const
+{
+    FRaceViewpointArray Viewpoints;
+    URaceVehicleSubsystem::GatherViewpoints(GetWorld(), Viewpoints);
+    if (Viewpoints.Num() == 0)
+    {
+        return true;
+    }
+
+    if (URaceVehicleSubsystem::MinDistanceToViewpoints(Viewpoints, Location) > URaceSettings::Get()->FXCullDistance)
+    {
+        return false;
+    }
+
+    // notes: looping trails follow a car back into view, so only one-shots get the frustum gate
+    if (Type != ERaceFX::BoostTrail)
+    {
+        const URaceSignificanceSubsystem* SignificanceSys = GetWorld()->GetSubsystem<URaceSignificanceSubsystem>();
+        return !SignificanceSys || SignificanceSys->ShouldSpawnFX(Location);
+    }
+    return true;
+}
+
+int32 URaceFXPoolSubsystem::ClaimComponent(FRaceFXPool& Pool) const
+{
+    // notes: a holder that went away without ReleaseFX (car destroyed) frees its slot
+    const int32 Num = Pool.Components.Num();
+    int32 Playing = INDEX_NONE;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        const int32 Index = (Pool.Next + i) % Num;
+        if (Pool.Holders[Index].IsValid())
+        {
+            continue;
+        }
+        if (!Pool.Components[Index]->IsActive())
+        {
+            return Index;
+        }
+        if (Playing == INDEX_NONE)
+        {
+            Playing = Index;
+        }
+    }
+    return Playing;
+}
+
+UNiagaraComponent* URaceFXPoolSubsystem::SpawnFX(ERaceFX Type, const FVector& Location, const FRotator& Rotation,
+    USceneComponent* AttachTo)
+{
+    FRaceFXPool& Pool = Pools[(int32)Type];
+    if (Pool.Components.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    // --- per-frame cap ---
+    if (SpawnFrame != GFrameCounter)
+    {
+        SpawnFrame = GFrameCounter;
+        SpawnsThisFrame = 0;
+    }
+    if (SpawnsThisFrame >= URaceSettings::Get()->MaxFXSpawnsPerFrame)
+    {
+        return nullptr;
+    }
+
+    if (!PassesCulling(Type, Location))
+    {
+        return nullptr;
+    }
+
+    // --- round-robin from Next: idle first, else the oldest one-shot still playing ---
+    const int32 Index = ClaimComponent(Pool);
+    if (Index == INDEX_NONE)
+    {
+        return nullptr;
+    }
+    ++SpawnsThisFrame;
+
+    UNiagaraComponent* Comp = Pool.Components[Index];
+    Pool.Next = (Index + 1) % Pool.Components.Num();
+    Pool.Holders[Index] = AttachTo;
+
+    if (Comp->IsActive())
+    {
+        Comp->DeactivateImmediate();
+    }
+
+    if (AttachTo)
+    {
+        Comp->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+    }
+    else
+    {
+        if (Comp->GetAttachParent())
+        {
+            Comp->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+        }
+        Comp->SetWorldLocationAndRotation(Location, Rotation);
+    }
+
+    // notes: culling just passed -> full rate until the next significance update rescales it
+    Comp->SetPaused(false);
+    Comp->SetFloatParameter(URaceSettings::Get()->FXSpawnScaleParameter, 1.f);
+    Comp->Activate(/*bReset*/true);
+    return Comp;
+}
+
+void URaceFXPoolSubsystem::ReleaseFX(UNiagaraComponent* Component, const USceneComponent* Holder)
+{
+    if (!Component || !Holder)
+    {
+        return;
+    }
+
+    for (FRaceFXPool& Pool : Pools)
+    {
+        const int32 Index = Pool.Components.Find(Component);
+        if (Index == INDEX_NONE)
+        {
+            continue;
+        }
+        // notes: a stale handle (the slot was freed and handed to someone else) must not stop their effect
+        if (Pool.Holders[Index].Get() != Holder || Component->GetAttachParent() != Holder)
+        {
+            return;
+        }
+        Pool.Holders[Index].Reset();
+        if (Component->IsActive())
+        {
+            Component->Deactivate();
+        }
+        return;
+    }
+}
@@ -4,6 +4,8 @@
 //        - spawn each player at a tagged PlayerStart (P1/P2)  KM
 // ============================================================================
 #include "RaceGameMode.h"
+#include "RaceInstanceSubsystem.h"
+#include "RaceStartupSubsystem.h"
 
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerStart.h"
@@ -19,6 +21,29 @@ ARaceGameMode::ARaceGameMode()
     // notes: leave defaults data-driven; we will set Default Pawn in BP GameMode. KM
 }
 
+// ----------------------------------------------------------------------------
+// StartPlay: start streaming race assets before actors BeginPlay so the async
+// load overlaps with it; Super dispatches BeginPlay to the whole level.
+// ----------------------------------------------------------------------------
+void ARaceGameMode::StartPlay()
+{
+    // notes: hosted headless instances share the host's startup subsystem; only the host map reports
+    URaceStartupSubsystem* Startup = URaceInstanceSubsystem::IsInstanceWorld(GetWorld())
+        ? nullptr : URaceStartupSubsystem::Get(this);
+    if (Startup)
+    {
+        Startup->BeginRacePreload(GetWorld());
+        Startup->BeginPhase(ERaceStartupPhase::ActorBeginPlay);
+    }
+
+    Super::StartPlay();
+
+    if (Startup)
+    {
+        Startup->EndPhase(ERaceStartupPhase::ActorBeginPlay);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // BeginPlay: make sure we have 2 LocalPlayers for split-screen
 // ----------------------------------------------------------------------------
@@ -33,6 +58,19 @@ void ARaceGameMode::BeginPlay()
         return;
     }
 
+    // notes: online race -> one player per client, no local split-screen P2
+    if (GetNetMode() != NM_Standalone)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[RaceGM] Networked race (NetMode=%d), skipping local P2"), (int32)GetNetMode());
+        return;
+    }
+
+    // notes: headless race instance (-RaceInstances) -> AI cars only, no local players
+    if (URaceInstanceSubsystem::IsInstanceWorld(World))
+    {
+        return;
+    }
+
     // notes: idempotent guard (dont spawn extra players on restart). KM
     if (World->GetNumPlayerControllers() >= 2)
     {
@@ -40,8 +78,21 @@ void ARaceGameMode::BeginPlay()
         return;
     }
 
+    URaceStartupSubsystem* Startup = URaceStartupSubsystem::Get(this);
+    if (Startup)
+    {
+        Startup->BeginPhase(ERaceStartupPhase::LocalPlayers);
+    }
+
     // notes: ControllerId 0 exists; request ControllerId 1 for second viewport. KM
-    if (UGameplayStatics::CreatePlayer(World, /*ControllerId*/1, /*bSpawnPawn*/true))
+    const bool bCreated = UGameplayStatics::CreatePlayer(World, /*ControllerId*/1, /*bSpawnPawn*/true) != nullptr;
+
+    if (Startup)
+    {
+        Startup->EndPhase(ERaceStartupPhase::LocalPlayers);
+    }
+
+    if (bCreated)
     {
         UE_LOG(LogTemp, Log, TEXT("[RaceGM] Created LocalPlayer #2 (split-screen ready)"));
     }
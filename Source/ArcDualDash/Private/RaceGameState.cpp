@@ -1,108 +1,247 @@
 ﻿#include "RaceGameState.h"
+#include "RaceMemory.h"
+#include "RaceAnalyticsSubsystem.h"
+#include "RaceLineData.h"
 #include "MyCar.h"
 #include "Checkpoints.h"
 #include "RacePlayerController.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
 #include "GameFramework/PlayerState.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+#include "Misc/MemStack.h"
+#include "Misc/StringBuilder.h"
 
 ARaceGameState::ARaceGameState()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // notes: race clock runs from URaceLogicSubsystem at a fixed rate, ranking from URaceAnalyticsSubsystem
+    PrimaryActorTick.bCanEverTick = false;
+
+    ReplicatedLeaderboard.Owner = this;
+}
+
+void ARaceGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(ARaceGameState, TotalLaps);
+    DOREPLIFETIME(ARaceGameState, CurrentLap);
+    DOREPLIFETIME(ARaceGameState, bTimerRunning);
+    DOREPLIFETIME(ARaceGameState, RaceStartServerTime);
+    DOREPLIFETIME(ARaceGameState, RaceEndServerTime);
+    DOREPLIFETIME(ARaceGameState, ReplicatedLeaderboard);
 }
 
 void ARaceGameState::BeginPlay()
 {
+    LLM_SCOPE_BYTAG(Race_State);
+
     Super::BeginPlay();
 
-    // --- Cache all checkpoint actors in order ---
-    TArray<AActor*> Found;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), ACheckpoints::StaticClass(), Found);
+    // --- Track layout: baked asset, runtime discovery only as a fallback ---
+    LoadTrackData();
+    LoadRacingLine();
+    NumCheckpoints = TrackData->Gates.Num();
 
-    if (Found.Num() == 0)
+    if (NumCheckpoints == 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("[RaceGameState] No checkpoints found in level!"));
         return;
     }
 
-    // Sort by CheckPointNo (lowest to highest)
-    Found.Sort([](const AActor& A, const AActor& B)
-        {
-            const int32 ANo = CastChecked<ACheckpoints>(&A)->CheckPointNo;
-            const int32 BNo = CastChecked<ACheckpoints>(&B)->CheckPointNo;
-            return ANo < BNo;
-        });
+    IntervalTable.Init(NumCheckpoints, URaceSettings::Get()->IntervalLapWindow);
 
-    TrackCheckpoints = Found;
-    NumCheckpoints = TrackCheckpoints.Num();
+    UE_LOG(LogTemp, Log, TEXT("[RaceGameState] Loaded %d checkpoints for leaderboard tracking."), NumCheckpoints);
 
-    // --- Validate checkpoint numbering ---
-    TSet<int32> Seen;
-    for (int32 i = 0; i < TrackCheckpoints.Num(); i++)
+    // notes: the clock runs from world start unless a mode stopped it; that is green light too
+    if (HasAuthority() && bTimerRunning)
     {
-        if (ACheckpoints* CP = Cast<ACheckpoints>(TrackCheckpoints[i]))
-        {
-            if (Seen.Contains(CP->CheckPointNo))
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[RaceGameState] Duplicate CheckPointNo found: %d (%s)"),
-                    CP->CheckPointNo, *CP->GetName());
-            }
-            Seen.Add(CP->CheckPointNo);
+        BeginQuietRace();
+    }
+}
 
-            UE_LOG(LogTemp, Log, TEXT("[RaceGameState] Checkpoint order %02d: %s (No=%d, StartFinish=%s)"),
-                i, *CP->GetName(), CP->CheckPointNo,
-                CP->bStartFinishLine ? TEXT("True") : TEXT("False"));
-        }
+void ARaceGameState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // notes: leaving mid-race must not keep automatic GC deferred for the next world
+    EndQuietRace();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ARaceGameState::LoadTrackData()
+{
+    // notes: tiny blob; sync load is cheaper than the discovery + validation it replaces
+    const FSoftObjectPath Path = URaceTrackData::GetAssetPathForWorld(GetWorld());
+    TrackData = Cast<URaceTrackData>(Path.TryLoad());
+    if (TrackData)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[RaceGameState] Track data %s: %d gates, %d sectors"),
+            *Path.ToString(), TrackData->Gates.Num(), TrackData->Sectors.Num());
+        return;
     }
 
-    // --- Start periodic leaderboard updates ---
-    GetWorldTimerManager().SetTimer(
-        LeaderboardTimerHandle,
-        this,
-        &ARaceGameState::UpdateLeaderboard,
-        0.5f,
-        true
-    );
+    UE_LOG(LogTemp, Warning, TEXT("[RaceGameState] %s not baked (run -run=RaceTrackBake); discovering checkpoints at runtime"),
+        *Path.ToString());
 
-    UE_LOG(LogTemp, Log, TEXT("[RaceGameState] Loaded %d checkpoints for leaderboard tracking."), NumCheckpoints);
+    TArray<FRaceTrackGate> Gates;
+    TArray<AActor*> Found;
+    UGameplayStatics::GetAllActorsOfClass(GetWorld(), ACheckpoints::StaticClass(), Found);
+    for (const AActor* Actor : Found)
+    {
+        Gates.Add(URaceTrackData::MakeGate(*CastChecked<ACheckpoints>(Actor)));
+    }
+
+    const URaceSettings* Settings = URaceSettings::Get();
+    TrackData = NewObject<URaceTrackData>(this, TEXT("TransientTrackData"));
+    TrackData->Bake(MoveTemp(Gates), Settings->RespawnSlotsPerGate, Settings->RespawnLaneSpacing, Settings->NumSectors);
 }
 
-void ARaceGameState::Tick(float DeltaSeconds)
+void ARaceGameState::LoadRacingLine()
 {
-    Super::Tick(DeltaSeconds);
+    const FSoftObjectPath Path = URaceLineData::GetAssetPathForWorld(GetWorld());
+    RacingLine = Cast<URaceLineData>(Path.TryLoad());
+    if (RacingLine && !RacingLine->Line.IsValid())
+    {
+        RacingLine = nullptr;
+    }
 
+    if (RacingLine)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[RaceGameState] Racing line %s: %d points, est. lap %.2fs"),
+            *Path.ToString(), RacingLine->Line.Points.Num(), RacingLine->EstimatedLapTime);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("[RaceGameState] %s not baked (run -run=RaceLineBake); AI follows the centreline"), *Path.ToString());
+    }
+}
+
+const FRaceTrackLine& ARaceGameState::GetTrackLine() const
+{
+    static const FRaceTrackLine Empty;
+    return TrackData ? TrackData->TrackLine : Empty;
+}
+
+const FRaceTrackLine& ARaceGameState::GetGuideLine() const
+{
+    return RacingLine ? RacingLine->Line : GetTrackLine();
+}
+
+void ARaceGameState::FixedRaceTick(float StepSeconds, uint64 StepCount)
+{
+    // notes: server and clients both read the clock off (synced) server world time, never
+    //        by summing steps: steps dropped after a hitch must not drop race time.
+    //        Leaderboard is ranked from the step's car snapshot (URaceAnalyticsSubsystem).
     if (bTimerRunning)
     {
-        ElapsedTime += DeltaSeconds;
+        ElapsedTime = GetRaceClock();
         OnTimeUpdated.Broadcast(ElapsedTime);
     }
+    else if (RaceEndServerTime > 0.f)
+    {
+        ElapsedTime = RaceEndServerTime - RaceStartServerTime;
+    }
+}
+
+float ARaceGameState::GetRaceClock() const
+{
+    return FMath::Max(0.f, (float)GetServerWorldTimeSeconds() - RaceStartServerTime);
+}
+
+float ARaceGameState::GetDisplayElapsedTime() const
+{
+    // notes: already real time; read it for this frame instead of interpolating the last step
+    return bTimerRunning ? GetRaceClock() : ElapsedTime;
 }
 
 void ARaceGameState::IncrementLapAndBroadcast()
 {
-    CurrentLap++;
+    // notes: counts every car's laps, so it is display only; the race ends in RegisterFinish
+    CurrentLap = FMath::Min(CurrentLap + 1, TotalLaps);
 
-    if (CurrentLap > TotalLaps)
-    {
-        CurrentLap = TotalLaps;
-        bTimerRunning = false;
-    }
+    OnLapChanged.Broadcast(CurrentLap, TotalLaps);
+}
 
+void ARaceGameState::OnRep_CurrentLap()
+{
     OnLapChanged.Broadcast(CurrentLap, TotalLaps);
 }
 
 void ARaceGameState::ResetTimer()
 {
     ElapsedTime = 0.f;
+    RaceStartServerTime = (float)GetServerWorldTimeSeconds();
+    RaceEndServerTime = 0.f;
+    IntervalTable.Reset();
+    NumFinished = 0;
     OnTimeUpdated.Broadcast(ElapsedTime);
+
+    BeginQuietRace();
 }
 
 void ARaceGameState::StopTimer()
 {
     bTimerRunning = false;
+    RaceEndServerTime = (float)GetServerWorldTimeSeconds();
+
+    EndQuietRace();
+}
+
+// ============================================================================
+// GC-quiet race: everything the race needs exists before green light (FX pools,
+// track data, HUD); in between nothing is created or destroyed, so GC is pushed
+// past the race and the incremental pass runs while the podium is up.
+// ============================================================================
+void ARaceGameState::BeginQuietRace()
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+    if (!Settings->bGCQuietRace || !GEngine)
+        return;
+
+    bQuietRace = true;
+    GEngine->SetTimeUntilNextGarbageCollection(Settings->QuietRaceMaxSeconds);
+    UE_LOG(LogTemp, Log, TEXT("[RaceGameState] Quiet race: GC deferred up to %.0fs"), Settings->QuietRaceMaxSeconds);
+}
+
+void ARaceGameState::EndQuietRace()
+{
+    if (!bQuietRace || !GEngine)
+        return;
+
+    bQuietRace = false;
+    GEngine->ForceGarbageCollection(/*bFullPurge*/false);
+}
+
+int32 ARaceGameState::RegisterFinish(int32 NumCars)
+{
+    ++NumFinished;
+    if (bTimerRunning && NumFinished >= NumCars)
+    {
+        StopTimer();
+    }
+    return NumFinished;
+}
+
+// ============================================================================
+// Checkpoint timing: one table slot per (lap, gate), see FRaceIntervalTable
+// ============================================================================
+void ARaceGameState::RecordCheckpointPass(AMyCar& Car)
+{
+    if (!HasAuthority() || Car.CurrentCheckpointIndex < 1)
+        return;
+
+    // notes: world time, not the logic-step clock, so passes inside one step still order
+    float Gap = 0.f;
+    float Interval = 0.f;
+    if (IntervalTable.RecordPass(Car.Lap, Car.CurrentCheckpointIndex - 1, GetWorld()->GetTimeSeconds(), Gap, Interval))
+    {
+        Car.GapToLeader = Gap;
+        Car.IntervalToAhead = Interval;
+    }
 }
 
 // ============================================================================
@@ -110,77 +249,226 @@ void ARaceGameState::StopTimer()
 // ============================================================================
 void ARaceGameState::UpdateLeaderboard()
 {
-    Leaderboard.Empty();
+    if (!HasAuthority())
+        return;
 
     if (NumCheckpoints == 0)
+    {
+        Leaderboard.Empty();
         return;
+    }
 
-    TArray<AActor*> FoundCars;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMyCar::StaticClass(), FoundCars);
+    if (URaceAnalyticsSubsystem* Analytics = URaceAnalyticsSubsystem::Get(this))
+    {
+        Analytics->Flush();
+    }
+}
+
+void ARaceGameState::ApplyRaceAnalytics(const FRaceAnalytics& Analytics)
+{
+    LLM_SCOPE_BYTAG(Race_Leaderboard);
 
-    for (AActor* Actor : FoundCars)
+    const float TrackLength = GetTrackLine().GetLength();
+
+    int32 NumRows = 0;
+    for (const FRaceStanding& Standing : Analytics.Standings)
+    {
+        // --- car may have been destroyed since the snapshot ---
+        AMyCar* Car = Standing.Car.Get();
+        if (!Car)
+            continue;
+
+        FPlayerRaceData& Data = ClaimLeaderboardRow(NumRows++, Car);
+        Data.Lap = Standing.Lap;
+        Data.Checkpoint = Standing.Checkpoint;
+        Data.ProgressKey = TrackLength > 0.f ? Standing.Progress / TrackLength : 0.f;
+        Data.DistanceToNext = Standing.DistanceToNext;
+        Data.GapToLeader = Car->GapToLeader;
+        Data.IntervalToAhead = Car->IntervalToAhead;
+
+        UE_LOG(LogTemp, Verbose, TEXT("[LeaderboardDebug] %s -> Lap=%d | CP=%d | DistToNext=%.1f | Gap=%.2fs | Int=%.2fs"),
+            *Data.PlayerName, Data.Lap, Data.Checkpoint, Data.DistanceToNext, Data.GapToLeader, Data.IntervalToAhead);
+    }
+    Leaderboard.SetNum(NumRows, EAllowShrinking::No);
+    RaceStats = Analytics.Stats;
+
+    SyncReplicatedLeaderboard();
+
+    for (const FRacePositionChange& Change : Analytics.PositionChanges)
     {
-        if (AMyCar* Car = Cast<AMyCar>(Actor))
+        if (AMyCar* Car = Change.Car.Get())
         {
-            FPlayerRaceData Data;
-            Data.Car = Car;
-            Data.Lap = Car->Lap;
-            Data.Checkpoint = Car->CurrentCheckpointIndex;
+            OnPositionChanged.Broadcast(Car, Change.OldPosition, Change.NewPosition);
+        }
+    }
 
-            // --- Identify player ---
-            if (Car->PlayerID > 0)
-            {
-                Data.PlayerName = FString::Printf(TEXT("Player %d"), Car->PlayerID);
-            }
-            else if (APlayerController* PC = Cast<APlayerController>(Car->GetController()))
-            {
-                if (ARacePlayerController* RPC = Cast<ARacePlayerController>(PC))
-                    Data.PlayerName = FString::Printf(TEXT("Player %d"), RPC->PlayerIndex);
-                else
-                    Data.PlayerName = TEXT("Player ?");
-            }
-            else
-            {
-                Data.PlayerName = TEXT("AI");
-            }
+    OnLeaderboardUpdated.Broadcast();
+}
 
-            // --- Distance to next checkpoint ---
-            float DistanceToNext = 999999.f;
+FString ARaceGameState::MakePlayerName(const AMyCar* Car)
+{
+    TStringBuilder<32> Name;
+    BuildPlayerName(Car, Name);
+    return FString(Name.ToString());
+}
 
-            if (TrackCheckpoints.IsValidIndex(Data.Checkpoint))
+void ARaceGameState::BuildPlayerName(const AMyCar* Car, FStringBuilderBase& Out)
+{
+    if (Car->PlayerID > 0)
+    {
+        Out << TEXT("Player ") << Car->PlayerID;
+    }
+    else if (const ARacePlayerController* RPC = Cast<ARacePlayerController>(Car->GetController()))
+    {
+        Out << TEXT("Player ") << RPC->PlayerIndex;
+    }
+    else if (Cast<APlayerController>(Car->GetController()))
+    {
+        Out << TEXT("Player ?");
+    }
+    else
+    {
+        Out << TEXT("AI");
+    }
+}
+
+FPlayerRaceData& ARaceGameState::ClaimLeaderboardRow(int32 Row, AMyCar* Car)
+{
+    // notes: rows are usually already in order; otherwise Car's old row is further down
+    if (!Leaderboard.IsValidIndex(Row) || Leaderboard[Row].Car != Car)
+    {
+        int32 Found = INDEX_NONE;
+        for (int32 i = Row + 1; i < Leaderboard.Num(); ++i)
+        {
+            if (Leaderboard[i].Car == Car)
             {
-                const int32 CurrIdx = Data.Checkpoint % NumCheckpoints;
-                const int32 NextIdx = (CurrIdx + 1) % NumCheckpoints;
+                Found = i;
+                break;
+            }
+        }
 
-                const FVector CarLoc = Car->GetActorLocation();
-                const FVector NextLoc = TrackCheckpoints[NextIdx]->GetActorLocation();
+        if (Found != INDEX_NONE)
+        {
+            Leaderboard.Swap(Row, Found);
+        }
+        else if (Row >= Leaderboard.Num())
+        {
+            Leaderboard.AddDefaulted();
+        }
+        Leaderboard[Row].Car = Car;
+    }
 
-                DistanceToNext = FVector::Dist(CarLoc, NextLoc);
-            }
+    // --- name changes only on possession / player id changes: rebuild on the stack, copy if different ---
+    FPlayerRaceData& Data = Leaderboard[Row];
+    TStringBuilder<32> Name;
+    BuildPlayerName(Car, Name);
+    if (!Name.ToView().Equals(Data.PlayerName, ESearchCase::CaseSensitive))
+    {
+        Data.PlayerName = Name.ToString();
+    }
+    return Data;
+}
 
-            Data.DistanceToNext = DistanceToNext;
+// ============================================================================
+// Replication: push sorted Leaderboard into the fast array, dirtying only
+// rows whose quantized progress changed (unchanged rows send nothing)
+// ============================================================================
+void ARaceGameState::SyncReplicatedLeaderboard()
+{
+    LLM_SCOPE_BYTAG(Race_Leaderboard);
+
+    if (GetNetMode() == NM_Standalone)
+        return;
 
-            Leaderboard.Add(Data);
+    TArray<FRaceLeaderboardEntry>& Items = ReplicatedLeaderboard.Items;
 
-            UE_LOG(LogTemp, Log, TEXT("[LeaderboardDebug] %s -> Lap=%d | CP=%d | DistToNext=%.1f"),
-                *Data.PlayerName, Data.Lap, Data.Checkpoint, Data.DistanceToNext);
+    // --- Drop rows for cars that left the race ---
+    bool bRemoved = false;
+    for (int32 i = Items.Num() - 1; i >= 0; --i)
+    {
+        const AMyCar* ItemCar = Items[i].Car;
+        if (!Leaderboard.ContainsByPredicate([ItemCar](const FPlayerRaceData& D) { return D.Car == ItemCar; }))
+        {
+            Items.RemoveAtSwap(i);
+            bRemoved = true;
         }
     }
+    if (bRemoved)
+    {
+        ReplicatedLeaderboard.MarkArrayDirty();
+    }
 
-    // --- Sort by Lap, then Checkpoint, then Distance ---
-    Leaderboard.Sort([](const FPlayerRaceData& A, const FPlayerRaceData& B)
+    // --- Add / update rows ---
+    for (int32 Pos = 0; Pos < Leaderboard.Num(); ++Pos)
+    {
+        const FPlayerRaceData& Data = Leaderboard[Pos];
+
+        FRaceLeaderboardEntry Quantized;
+        Quantized.Car = Data.Car;
+        Quantized.Position = (uint8)FMath::Min(Pos + 1, 255);
+        Quantized.Lap = (uint8)FMath::Clamp(Data.Lap, 0, 255);
+        Quantized.Checkpoint = (uint8)FMath::Clamp(Data.Checkpoint, 0, 255);
+        Quantized.DistanceToNextM = (uint16)FMath::Clamp(FMath::RoundToInt(Data.DistanceToNext / 100.f), 0, 65535);
+        Quantized.ProgressMilliLaps = (uint16)FMath::Clamp(FMath::RoundToInt(Data.ProgressKey * 1000.f), 0, 65535);
+
+        FRaceLeaderboardEntry* Existing = Items.FindByPredicate(
+            [&Data](const FRaceLeaderboardEntry& E) { return E.Car == Data.Car; });
+
+        if (!Existing)
+        {
+            FRaceLeaderboardEntry& Added = Items.Add_GetRef(Quantized);
+            ReplicatedLeaderboard.MarkItemDirty(Added);
+        }
+        else if (!Existing->HasSameProgress(Quantized))
         {
-            // Higher lap wins
-            if (A.Lap != B.Lap)
-                return A.Lap > B.Lap;
+            Existing->Position = Quantized.Position;
+            Existing->Lap = Quantized.Lap;
+            Existing->Checkpoint = Quantized.Checkpoint;
+            Existing->DistanceToNextM = Quantized.DistanceToNextM;
+            Existing->ProgressMilliLaps = Quantized.ProgressMilliLaps;
+            ReplicatedLeaderboard.MarkItemDirty(*Existing);
+        }
+    }
+}
+
+void FRaceLeaderboardArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+    if (Owner)
+    {
+        Owner->HandleLeaderboardReplicated();
+    }
+}
 
-            // Same lap: higher checkpoint wins
-            if (A.Checkpoint != B.Checkpoint)
-                return A.Checkpoint > B.Checkpoint;
+void ARaceGameState::HandleLeaderboardReplicated()
+{
+    LLM_SCOPE_BYTAG(Race_Leaderboard);
 
-            // Same lap and checkpoint: closer to next checkpoint wins
-            return A.DistanceToNext < B.DistanceToNext;
+    // --- Fast array order is arbitrary; Position is the server ranking (scratch on the frame stack) ---
+    FMemMark Mark(FMemStack::Get());
+    TArray<const FRaceLeaderboardEntry*, TMemStackAllocator<>> Sorted;
+    Sorted.Reserve(ReplicatedLeaderboard.Items.Num());
+    for (const FRaceLeaderboardEntry& E : ReplicatedLeaderboard.Items)
+    {
+        if (E.Car) // car actor may not be replicated to us yet
+            Sorted.Add(&E);
+    }
+    Sorted.Sort([](const FRaceLeaderboardEntry& A, const FRaceLeaderboardEntry& B)
+        {
+            return A.Position < B.Position;
         });
 
+    for (int32 Row = 0; Row < Sorted.Num(); ++Row)
+    {
+        const FRaceLeaderboardEntry* E = Sorted[Row];
+        FPlayerRaceData& Data = ClaimLeaderboardRow(Row, E->Car);
+        Data.Lap = E->Lap;
+        Data.Checkpoint = E->Checkpoint;
+        Data.ProgressKey = E->ProgressMilliLaps / 1000.f;
+        Data.DistanceToNext = E->DistanceToNextM * 100.f;
+        Data.GapToLeader = E->Car->GapToLeader;
+        Data.IntervalToAhead = E->Car->IntervalToAhead;
+    }
+    Leaderboard.SetNum(Sorted.Num(), EAllowShrinking::No);
+
     OnLeaderboardUpdated.Broadcast();
 }
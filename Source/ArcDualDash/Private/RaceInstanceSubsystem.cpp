@@ -0,0 +1,346 @@
+// ============================================================================
+// RaceInstanceSubsystem.cpp
+// notes: every instance world lives in its own /Temp/RaceInstance<N>/<Map>
+//        package. The short name matches the track map so the baked
+//        URaceTrackData resolves exactly as it does for the real map.
+// ============================================================================
+#include "RaceInstanceSubsystem.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceGameState.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
+#include "RaceTrainingSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+static const TCHAR* InstancePackageRoot = TEXT("/Temp/RaceInstance");
+
+URaceInstanceSubsystem* URaceInstanceSubsystem::Get(const UObject* WorldContext)
+{
+    const UGameInstance* GI = UGameplayStatics::GetGameInstance(WorldContext);
+    return GI ? GI->GetSubsystem<URaceInstanceSubsystem>() : nullptr;
+}
+
+bool URaceInstanceSubsystem::IsInstanceWorld(const UWorld* World)
+{
+    return World && World->GetOutermost()->GetName().StartsWith(InstancePackageRoot);
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+bool URaceInstanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    int32 Requested = 0;
+    return Super::ShouldCreateSubsystem(Outer)
+        && FParse::Value(FCommandLine::Get(), TEXT("RaceInstances="), Requested)
+        && Requested > 0;
+}
+
+void URaceInstanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    FParse::Value(FCommandLine::Get(), TEXT("RaceInstances="), RequestedInstances);
+    FParse::Value(FCommandLine::Get(), TEXT("RaceInstanceMap="), MapPackageName);
+
+    CarsPerInstance = URaceSettings::Get()->InstanceCarsPerRace;
+    FParse::Value(FCommandLine::Get(), TEXT("RaceInstanceCars="), CarsPerInstance);
+    CarsPerInstance = FMath::Max(1, CarsPerInstance);
+
+    // notes: instances are created once the host map is up, so the game instance is fully initialised
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &URaceInstanceSubsystem::HandlePostLoadMap);
+
+    StatusCommand = IConsoleManager::Get().RegisterConsoleCommand(
+        TEXT("race.Instances"),
+        TEXT("Print the state of every hosted race instance."),
+        FConsoleCommandDelegate::CreateUObject(this, &URaceInstanceSubsystem::PrintStatus),
+        ECVF_Default);
+}
+
+void URaceInstanceSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    if (StatusCommand)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(StatusCommand);
+        StatusCommand = nullptr;
+    }
+
+    DestroyInstances();
+
+    Super::Deinitialize();
+}
+
+void URaceInstanceSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    if (Instances.Num() > 0 || !LoadedWorld || IsInstanceWorld(LoadedWorld))
+    {
+        return;
+    }
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+    if (MapPackageName.IsEmpty())
+    {
+        MapPackageName = UWorld::RemovePIEPrefix(LoadedWorld->GetOutermost()->GetName());
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Instances] Hosting %d x %s, %d cars each"),
+        RequestedInstances, *MapPackageName, CarsPerInstance);
+
+    for (int32 i = 0; i < RequestedInstances; ++i)
+    {
+        if (!CreateInstance(i))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[Instances] Instance %d failed to load %s"), i, *MapPackageName);
+        }
+    }
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &URaceInstanceSubsystem::TickInstances), 0.5f);
+}
+
+// ============================================================================
+// Instance creation
+// ============================================================================
+bool URaceInstanceSubsystem::CreateInstance(int32 Index)
+{
+    const FString ShortName = FPackageName::GetShortName(MapPackageName);
+    UPackage* Package = CreatePackage(*FString::Printf(TEXT("%s%d/%s"), InstancePackageRoot, Index, *ShortName));
+    Package->SetPackageFlags(PKG_ContainsMap);
+
+    // notes: own world -> own FPhysScene, subsystems, game mode and game state
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld*/false, FName(*ShortName), Package);
+    FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.OwningGameInstance = GetGameInstance();
+    Context.SetCurrentWorld(World);
+    World->SetGameInstance(GetGameInstance());
+
+    bool bLoaded = false;
+    ULevelStreamingDynamic::LoadLevelInstance(World, MapPackageName, FVector::ZeroVector, FRotator::ZeroRotator, bLoaded);
+    if (!bLoaded)
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(/*bInformEngineOfWorld*/false);
+        return false;
+    }
+    World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+    // notes: same order as UEngine::LoadMap; no URL options, so the project default game mode
+    const FURL URL;
+    World->SetGameMode(URL);
+    World->InitializeActorsForPlay(URL);
+    World->BeginPlay();
+
+    TArray<AMyCar*> Cars;
+    SpawnGridCars(World, CarsPerInstance, Cars);
+
+    // notes: nobody else drives instance cars, unless a trainer is stepping them
+    if (!GetGameInstance()->GetSubsystem<URaceTrainingSubsystem>())
+    {
+        for (AMyCar* Car : Cars)
+        {
+            Car->bLineDriver = true;
+        }
+    }
+
+    // notes: only the bookkeeping is ours; world, level and actor memory keep the engine's own tags
+    {
+        LLM_SCOPE_BYTAG(Race_State);
+        FRaceInstance& Instance = Instances.AddDefaulted_GetRef();
+        Instance.World = World;
+        Instance.StartTime = FPlatformTime::Seconds();
+        Instance.Cars.Append(Cars);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Instances] #%d up: %s, %d cars"), Index, *Package->GetName(), Cars.Num());
+    return true;
+}
+
+void URaceInstanceSubsystem::SpawnGridCars(UWorld* World, int32 NumCars, TArray<AMyCar*>& OutCars)
+{
+    const ARaceGameState* GS = World->GetGameState<ARaceGameState>();
+    const URaceTrackData* Track = GS ? GS->GetTrackData() : nullptr;
+    if (!Track || Track->Gates.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[Instances] %s has no track data, no cars spawned"), *World->GetOutermost()->GetName());
+        return;
+    }
+
+    UClass* CarClass = nullptr;
+    if (AGameModeBase* GM = World->GetAuthGameMode())
+    {
+        CarClass = GM->GetDefaultPawnClassForController(nullptr);
+    }
+    if (!CarClass || !CarClass->IsChildOf<AMyCar>())
+    {
+        CarClass = AMyCar::StaticClass();
+    }
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    // --- grid: rows of SlotsPerGate lanes, filling gates backwards from the start line ---
+    const int32 NumGates = Track->Gates.Num();
+    const int32 Lanes = FMath::Max(1, Track->SlotsPerGate);
+    for (int32 i = 0; i < NumCars; ++i)
+    {
+        const int32 Row = i / Lanes;
+        const int32 GateIndex = ((NumGates - 1 - Row) % NumGates + NumGates) % NumGates;
+
+        FTransform Slot;
+        if (!Track->GetRespawnSlot(GateIndex, i % Lanes, Slot))
+        {
+            Slot = FTransform(Track->Gates[GateIndex].Rotation, Track->Gates[GateIndex].Location);
+        }
+
+        AMyCar* Car = World->SpawnActor<AMyCar>(CarClass, Slot, Params);
+        if (!Car)
+        {
+            continue;
+        }
+        Car->bIsAI = true;
+        Car->PlayerID = i + 1;
+        Car->SpawnDefaultController();
+        OutCars.Add(Car);
+    }
+}
+
+void URaceInstanceSubsystem::DestroyInstances()
+{
+    for (FRaceInstance& Instance : Instances)
+    {
+        // notes: on engine shutdown the world list may already have been torn down
+        UWorld* World = Instance.World;
+        if (World && GEngine->GetWorldContextFromWorld(World))
+        {
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(/*bInformEngineOfWorld*/false);
+        }
+    }
+    Instances.Reset();
+}
+
+// ============================================================================
+// Progress + results
+// ============================================================================
+bool URaceInstanceSubsystem::TickInstances(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    const float Timeout = URaceSettings::Get()->InstanceTimeoutSeconds;
+
+    int32 NumDone = 0;
+    for (FRaceInstance& Instance : Instances)
+    {
+        if (!Instance.bFinished)
+        {
+            const ARaceGameState* GS = Instance.World ? Instance.World->GetGameState<ARaceGameState>() : nullptr;
+            if (!GS || !GS->bTimerRunning)
+            {
+                Instance.bFinished = true;
+            }
+            else if (Timeout > 0.f && Now - Instance.StartTime > Timeout)
+            {
+                Instance.bFinished = true;
+                Instance.bTimedOut = true;
+            }
+
+            if (Instance.bFinished)
+            {
+                Instance.EndTime = Now;
+            }
+        }
+        NumDone += Instance.bFinished ? 1 : 0;
+    }
+
+    if (NumDone < Instances.Num() || bResultsWritten)
+    {
+        return true;
+    }
+
+    WriteResults();
+    bResultsWritten = true;
+
+    if (URaceSettings::Get()->bExitWhenInstancesFinish)
+    {
+        FPlatformMisc::RequestExit(/*bForce*/false, TEXT("RaceInstances"));
+    }
+    return false;
+}
+
+void URaceInstanceSubsystem::WriteResults() const
+{
+    FString Csv = TEXT("Instance,Result,RaceSeconds,WallSeconds,Position,Player,Lap,Checkpoint\n");
+
+    int32 NumFinished = 0;
+    double TotalRaceSeconds = 0.0;
+    for (int32 i = 0; i < Instances.Num(); ++i)
+    {
+        const FRaceInstance& Instance = Instances[i];
+        ARaceGameState* GS = Instance.World ? Instance.World->GetGameState<ARaceGameState>() : nullptr;
+        if (!GS)
+        {
+            continue;
+        }
+
+        // notes: the periodic re-rank can be up to one interval old
+        GS->UpdateLeaderboard();
+
+        const TCHAR* Result = Instance.bTimedOut ? TEXT("timeout") : TEXT("finished");
+        const double WallSeconds = Instance.EndTime - Instance.StartTime;
+        if (!Instance.bTimedOut)
+        {
+            ++NumFinished;
+            TotalRaceSeconds += GS->ElapsedTime;
+        }
+
+        for (int32 Pos = 0; Pos < GS->Leaderboard.Num(); ++Pos)
+        {
+            const FPlayerRaceData& Data = GS->Leaderboard[Pos];
+            Csv += FString::Printf(TEXT("%d,%s,%.3f,%.3f,%d,%s,%d,%d\n"),
+                i, Result, GS->ElapsedTime, WallSeconds, Pos + 1, *Data.PlayerName, Data.Lap, Data.Checkpoint);
+        }
+    }
+
+    const FString Path = FPaths::ProjectSavedDir() / TEXT("RaceInstances") / TEXT("Results.csv");
+    FFileHelper::SaveStringToFile(Csv, *Path);
+
+    UE_LOG(LogTemp, Log, TEXT("[Instances] %d / %d finished, mean race time %.2fs -> %s"),
+        NumFinished, Instances.Num(), NumFinished > 0 ? TotalRaceSeconds / NumFinished : 0.0, *Path);
+}
+
+void URaceInstanceSubsystem::PrintStatus() const
+{
+    const double Now = FPlatformTime::Seconds();
+    UE_LOG(LogTemp, Log, TEXT("[Instances] ---- %d race instances (%s) ----"), Instances.Num(), *MapPackageName);
+
+    for (int32 i = 0; i < Instances.Num(); ++i)
+    {
+        const FRaceInstance& Instance = Instances[i];
+        const ARaceGameState* GS = Instance.World ? Instance.World->GetGameState<ARaceGameState>() : nullptr;
+        const double Wall = (Instance.bFinished ? Instance.EndTime : Now) - Instance.StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("[Instances] #%-3d %-9s cars=%-3d race=%7.2fs wall=%7.2fs leader=%s"),
+            i,
+            Instance.bTimedOut ? TEXT("timeout") : (Instance.bFinished ? TEXT("finished") : TEXT("running")),
+            Instance.Cars.Num(),
+            GS ? GS->ElapsedTime : 0.f,
+            Wall,
+            GS && GS->Leaderboard.Num() > 0 ? *GS->Leaderboard[0].PlayerName : TEXT("-"));
+    }
+}
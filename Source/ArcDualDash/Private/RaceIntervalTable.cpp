@@ -0,0 +1,54 @@
+// ============================================================================
+// RaceIntervalTable.cpp
+// notes: slots are LapWindow * NumGates, allocated once per race.
+// ============================================================================
+#include "RaceIntervalTable.h"
+#include "RaceMemory.h"
+
+void FRaceIntervalTable::Init(int32 InNumGates, int32 InLapWindow)
+{
+    LLM_SCOPE_BYTAG(Race_Leaderboard);
+
+    NumGates = FMath::Max(0, InNumGates);
+    LapWindow = FMath::Max(1, InLapWindow);
+    Slots.SetNum(NumGates * LapWindow);
+    Reset();
+}
+
+void FRaceIntervalTable::Reset()
+{
+    for (FSlot& Slot : Slots)
+    {
+        Slot = FSlot();
+    }
+}
+
+bool FRaceIntervalTable::RecordPass(int32 Lap, int32 Gate, double Time, float& OutGapToLeader, float& OutInterval)
+{
+    if (!IsValid() || Gate < 0 || Gate >= NumGates || Lap < 0)
+    {
+        return false;
+    }
+
+    FSlot& Slot = Slots[(Lap % LapWindow) * NumGates + Gate];
+    if (Slot.Lap > Lap)
+    {
+        return false;
+    }
+
+    // --- first car through on this lap: it leads here, the slot is (re)claimed ---
+    if (Slot.Lap < Lap)
+    {
+        Slot.Lap = Lap;
+        Slot.FirstTime = Time;
+        Slot.LastTime = Time;
+        OutGapToLeader = 0.f;
+        OutInterval = 0.f;
+        return true;
+    }
+
+    OutGapToLeader = (float)(Time - Slot.FirstTime);
+    OutInterval = (float)(Time - Slot.LastTime);
+    Slot.LastTime = Time;
+    return true;
+}
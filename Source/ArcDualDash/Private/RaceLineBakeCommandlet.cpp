@@ -0,0 +1,106 @@
+// ============================================================================
+// RaceLineBakeCommandlet.cpp
+// notes: editor-only work is behind WITH_EDITOR; in cooked builds the
+//        commandlet exists but refuses to run. The optimisation itself
+//        (URaceLineData::Bake) spreads each pass over the task graph.
+// ============================================================================
+#include "RaceLineBakeCommandlet.h"
+#include "RaceLineData.h"
+#include "RaceTrackData.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "GameMapsSettings.h"
+#include "UObject/SavePackage.h"
+#endif
+
+URaceLineBakeCommandlet::URaceLineBakeCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 URaceLineBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    TArray<FString> Maps;
+    FString MapParam;
+    if (FParse::Value(*Params, TEXT("Map="), MapParam, /*bShouldStopOnSeparator*/false))
+    {
+        MapParam.ParseIntoArray(Maps, TEXT(","));
+    }
+    else
+    {
+        Maps.Add(FSoftObjectPath(UGameMapsSettings::GetGameDefaultMap()).GetLongPackageName());
+    }
+
+    int32 Failures = 0;
+    for (const FString& Map : Maps)
+    {
+        if (!BakeMap(Map.TrimStartAndEnd()))
+        {
+            ++Failures;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("[LineBake] %d map(s) baked, %d failed"), Maps.Num() - Failures, Failures);
+    return Failures == 0 ? 0 : 1;
+#else
+    UE_LOG(LogTemp, Error, TEXT("[LineBake] Needs an editor build"));
+    return 1;
+#endif
+}
+
+bool URaceLineBakeCommandlet::BakeMap(const FString& MapPackageName)
+{
+#if WITH_EDITOR
+    const FSoftObjectPath TrackPath(URaceTrackData::GetAssetPathForMap(MapPackageName));
+    const URaceTrackData* Track = Cast<URaceTrackData>(TrackPath.TryLoad());
+    if (!Track)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[LineBake] %s not baked; run -run=RaceTrackBake -Map=%s first"),
+            *TrackPath.ToString(), *MapPackageName);
+        return false;
+    }
+
+    // --- Bake into <TrackDataPath>/<MapName>_Line ---
+    const FString AssetPath = URaceLineData::GetAssetPathForMap(MapPackageName);
+    const FString PackageName = FPackageName::ObjectPathToPackageName(AssetPath);
+    const FString AssetName = FPackageName::ObjectPathToObjectName(AssetPath);
+
+    UPackage* AssetPackage = CreatePackage(*PackageName);
+    AssetPackage->FullyLoad();
+
+    URaceLineData* Data = FindObject<URaceLineData>(AssetPackage, *AssetName);
+    if (!Data)
+    {
+        Data = NewObject<URaceLineData>(AssetPackage, *AssetName, RF_Public | RF_Standalone);
+        FAssetRegistryModule::AssetCreated(Data);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bValid = Data->Bake(*Track, FRaceLineBakeParams::FromSettings());
+    const double BakeSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // --- Save ---
+    Data->MarkPackageDirty();
+    const FString Filename = FPackageName::LongPackageNameToFilename(AssetPackage->GetName(), FPackageName::GetAssetPackageExtension());
+
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    const bool bSaved = Data->Line.IsValid() && UPackage::SavePackage(AssetPackage, Data, *Filename, SaveArgs);
+
+    UE_LOG(LogTemp, Display, TEXT("[LineBake] %s -> %s: %d points, %.0f cm (centreline %.0f cm), est. lap %.2fs, %.2fs to optimise%s"),
+        *MapPackageName, *Filename, Data->Line.Points.Num(), Data->Line.GetLength(), Track->TrackLine.GetLength(),
+        Data->EstimatedLapTime, BakeSeconds, bValid ? TEXT("") : TEXT(" (WITH WARNINGS)"));
+
+    return bSaved && bValid;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,249 @@
+// ============================================================================
+// RaceLineData.cpp
+// notes: the line is an offset along each corridor point's normal, relaxed
+//        towards minimum curvature (Jacobi, so every point of a pass runs in
+//        parallel) coarse to fine. Offline only; runtime just samples.
+// ============================================================================
+#include "RaceLineData.h"
+#include "RaceMemory.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace RaceLine
+{
+    // coarse-to-fine levels: point spacing x8, x4, x2, x1
+    constexpr int32 NumLevels = 4;
+
+    // notes: damped Jacobi; undamped passes oscillate on the 4th-order stencil
+    constexpr float Relax = 0.5f;
+
+    struct FCorridor
+    {
+        TArray<FVector> Centre;
+        TArray<FVector> Normal;     // horizontal, right of travel
+        TArray<float> HalfWidth;    // usable, edge margin removed
+
+        int32 Num() const { return Centre.Num(); }
+        FVector GetPoint(const TArray<float>& Offsets, int32 i) const
+        {
+            i = (i % Num() + Num()) % Num();
+            return Centre[i] + Normal[i] * Offsets[i];
+        }
+    };
+
+    // notes: centreline points are the gates (URaceTrackData::Bake), so a segment index is a gate index
+    static void BuildCorridor(const URaceTrackData& Track, int32 NumPoints, float EdgeMargin, FCorridor& Out)
+    {
+        const FRaceTrackLine& Centreline = Track.TrackLine;
+        const float Length = Centreline.GetLength();
+        const int32 NumGates = Track.Gates.Num();
+
+        Out.Centre.SetNumUninitialized(NumPoints);
+        Out.Normal.SetNumUninitialized(NumPoints);
+        Out.HalfWidth.SetNumUninitialized(NumPoints);
+
+        ParallelFor(NumPoints, [&](int32 i)
+        {
+            const float Distance = Length * i / NumPoints;
+            FVector Direction;
+            Centreline.Sample(Distance, Out.Centre[i], Direction);
+
+            float Alpha = 0.f;
+            const int32 Gate = Centreline.Locate(Distance, Alpha);
+            const float Width = FMath::Lerp(Track.Gates[Gate].HalfWidth, Track.Gates[(Gate + 1) % NumGates].HalfWidth, Alpha);
+            Out.HalfWidth[i] = FMath::Max(Width - EdgeMargin, 0.f);
+        });
+
+        // --- normals from the neighbours, so they turn smoothly through the kink at a gate ---
+        ParallelFor(NumPoints, [&](int32 i)
+        {
+            const FVector Tangent = Out.Centre[(i + 1) % NumPoints] - Out.Centre[(i + NumPoints - 1) % NumPoints];
+            Out.Normal[i] = FVector::CrossProduct(FVector::UpVector, Tangent).GetSafeNormal2D();
+        });
+    }
+
+    static void ResampleOffsets(TArray<float>& Offsets, int32 NumPoints)
+    {
+        if (Offsets.Num() == 0)
+        {
+            Offsets.SetNumZeroed(NumPoints);
+            return;
+        }
+
+        TArray<float> Resampled;
+        Resampled.SetNumUninitialized(NumPoints);
+        const int32 NumCoarse = Offsets.Num();
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            const float X = (float)i * NumCoarse / NumPoints;
+            const int32 A = FMath::FloorToInt(X);
+            Resampled[i] = FMath::Lerp(Offsets[A % NumCoarse], Offsets[(A + 1) % NumCoarse], X - A);
+        }
+        Offsets = MoveTemp(Resampled);
+    }
+
+    // notes: each point moves to the minimiser of sum |P[j-1] - 2 P[j] + P[j+1]|^2 over its own
+    //        position (neighbours fixed), restricted to its normal and clamped to the corridor
+    static void RelaxOffsets(const FCorridor& Corridor, int32 Iterations, TArray<float>& Offsets)
+    {
+        TArray<float> Next;
+        Next.SetNumUninitialized(Corridor.Num());
+
+        for (int32 Pass = 0; Pass < Iterations; ++Pass)
+        {
+            ParallelFor(Corridor.Num(), [&](int32 i)
+            {
+                const FVector Target = (4.0 * (Corridor.GetPoint(Offsets, i - 1) + Corridor.GetPoint(Offsets, i + 1))
+                    - (Corridor.GetPoint(Offsets, i - 2) + Corridor.GetPoint(Offsets, i + 2))) / 6.0;
+                const float Best = FVector::DotProduct(Target - Corridor.Centre[i], Corridor.Normal[i]);
+                const float Width = Corridor.HalfWidth[i];
+                Next[i] = FMath::Clamp(FMath::Lerp(Offsets[i], Best, Relax), -Width, Width);
+            });
+            Swap(Offsets, Next);
+        }
+    }
+
+    // notes: grip limit per point, then accel (forward) and brake (backward) limits;
+    //        two laps per sweep so the profile closes over the start line. Returns the lap time.
+    static float BuildSpeedProfile(const FRaceTrackLine& Line, const FRaceLineBakeParams& Params, TArray<float>& OutSpeeds)
+    {
+        const int32 Num = Line.Points.Num();
+        OutSpeeds.SetNumUninitialized(Num);
+
+        ParallelFor(Num, [&](int32 i)
+        {
+            // curvature of the circle through the point and its neighbours
+            const FVector& A = Line.Points[(i + Num - 1) % Num];
+            const FVector& B = Line.Points[i];
+            const FVector& C = Line.Points[(i + 1) % Num];
+            const double Denom = FVector::Dist(A, B) * FVector::Dist(B, C) * FVector::Dist(A, C);
+            const double Curvature = Denom > UE_KINDA_SMALL_NUMBER ? 2.0 * FVector::CrossProduct(B - A, C - B).Size() / Denom : 0.0;
+
+            OutSpeeds[i] = Curvature > UE_KINDA_SMALL_NUMBER
+                ? FMath::Min(Params.MaxSpeed, (float)FMath::Sqrt(Params.LateralAccel / Curvature))
+                : Params.MaxSpeed;
+        });
+
+        auto SegmentLength = [&Line](int32 Segment) { return Line.CumulativeLength[Segment + 1] - Line.CumulativeLength[Segment]; };
+
+        for (int32 k = 1; k <= 2 * Num; ++k)
+        {
+            const int32 Prev = (k - 1) % Num;
+            const int32 i = k % Num;
+            OutSpeeds[i] = FMath::Min(OutSpeeds[i], FMath::Sqrt(FMath::Square(OutSpeeds[Prev]) + 2.f * Params.Accel * SegmentLength(Prev)));
+        }
+        for (int32 k = 2 * Num; k >= 1; --k)
+        {
+            const int32 i = (k - 1) % Num;
+            const int32 Next = k % Num;
+            OutSpeeds[i] = FMath::Min(OutSpeeds[i], FMath::Sqrt(FMath::Square(OutSpeeds[Next]) + 2.f * Params.Brake * SegmentLength(i)));
+        }
+
+        float LapTime = 0.f;
+        for (int32 Segment = 0; Segment < Num; ++Segment)
+        {
+            LapTime += SegmentLength(Segment) / FMath::Max(0.5f * (OutSpeeds[Segment] + OutSpeeds[(Segment + 1) % Num]), 1.f);
+        }
+        return LapTime;
+    }
+}
+
+FRaceLineBakeParams FRaceLineBakeParams::FromSettings()
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+
+    FRaceLineBakeParams Params;
+    Params.Spacing = Settings->RacingLineSpacing;
+    Params.Iterations = Settings->RacingLineIterations;
+    Params.EdgeMargin = Settings->RacingLineEdgeMargin;
+    Params.MaxSpeed = Settings->RacingLineMaxSpeed;
+    Params.LateralAccel = Settings->RacingLineLateralAccel;
+    Params.Accel = Settings->RacingLineAccel;
+    Params.Brake = Settings->RacingLineBrake;
+    return Params;
+}
+
+float URaceLineData::GetTargetSpeed(float Distance) const
+{
+    if (!Line.IsValid() || TargetSpeeds.Num() != Line.Points.Num())
+    {
+        return 0.f;
+    }
+
+    float Alpha = 0.f;
+    const int32 Segment = Line.Locate(Distance, Alpha);
+    return FMath::Lerp(TargetSpeeds[Segment], TargetSpeeds[(Segment + 1) % TargetSpeeds.Num()], Alpha);
+}
+
+// ============================================================================
+// Bake
+// ============================================================================
+bool URaceLineData::Bake(const URaceTrackData& Track, const FRaceLineBakeParams& Params)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    Line.Build({});
+    TargetSpeeds.Reset();
+    EstimatedLapTime = 0.f;
+
+    const FRaceTrackLine& Centreline = Track.TrackLine;
+    if (Track.Gates.Num() < 3 || !Centreline.bClosedLoop || Centreline.Points.Num() != Track.Gates.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[RaceLine] Needs a baked closed track with at least 3 gates"));
+        return false;
+    }
+
+    bool bValid = true;
+    if (!Track.Gates.ContainsByPredicate([](const FRaceTrackGate& Gate) { return Gate.HalfWidth > 0.f; }))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[RaceLine] Gates have no width (re-run RaceTrackBake); line stays on the centreline"));
+        bValid = false;
+    }
+
+    // --- coarse to fine: long bends settle on the coarse levels, fine levels only add detail ---
+    const float Length = Centreline.GetLength();
+    const float Spacing = FMath::Max(Params.Spacing, 10.f);
+    TArray<float> Offsets;
+    RaceLine::FCorridor Corridor;
+    for (int32 Level = RaceLine::NumLevels - 1; Level >= 0; --Level)
+    {
+        const int32 NumPoints = FMath::Max(FMath::CeilToInt(Length / (Spacing * (1 << Level))), Track.Gates.Num());
+        RaceLine::BuildCorridor(Track, NumPoints, Params.EdgeMargin, Corridor);
+        RaceLine::ResampleOffsets(Offsets, NumPoints);
+        RaceLine::RelaxOffsets(Corridor, Params.Iterations, Offsets);
+    }
+
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(Corridor.Num());
+    for (int32 i = 0; i < Corridor.Num(); ++i)
+    {
+        Points[i] = Corridor.GetPoint(Offsets, i);
+    }
+    Line.Build(Points, /*bClosedLoop*/true);
+
+    EstimatedLapTime = RaceLine::BuildSpeedProfile(Line, Params, TargetSpeeds);
+    return bValid;
+}
+
+// ============================================================================
+// Asset lookup
+// ============================================================================
+FString URaceLineData::GetAssetPathForMap(const FString& MapPackageName)
+{
+    const FString AssetName = FPackageName::GetShortName(MapPackageName) + TEXT("_Line");
+    return URaceSettings::Get()->TrackDataPath / AssetName + TEXT(".") + AssetName;
+}
+
+FSoftObjectPath URaceLineData::GetAssetPathForWorld(const UWorld* World)
+{
+    if (!World)
+    {
+        return FSoftObjectPath();
+    }
+    const FString MapPackageName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+    return FSoftObjectPath(GetAssetPathForMap(MapPackageName));
+}
@@ -0,0 +1,132 @@
+// ============================================================================
+// RaceLogicSubsystem.cpp
+// notes: cars are stepped in registry order so a run with the same inputs
+//        produces the same sequence of logic updates.
+// ============================================================================
+#include "RaceLogicSubsystem.h"
+#include "MyCar.h"
+#include "RaceAnalyticsSubsystem.h"
+#include "RaceGameState.h"
+#include "RaceMallocCounter.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
+#include "RaceVehicleSubsystem.h"
+
+#include "Engine/World.h"
+#include "Misc/MemStack.h"
+
+bool URaceLogicSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URaceLogicSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URaceLogicSubsystem, STATGROUP_Tickables);
+}
+
+URaceLogicSubsystem* URaceLogicSubsystem::Get(const UObject* WorldContext)
+{
+    const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<URaceLogicSubsystem>() : nullptr;
+}
+
+float URaceLogicSubsystem::GetFixedStep() const
+{
+    return 1.f / URaceSettings::Get()->RaceLogicHz;
+}
+
+// ============================================================================
+// Accumulator
+// ============================================================================
+void URaceLogicSubsystem::Tick(float DeltaTime)
+{
+    const float StepSeconds = GetFixedStep();
+    const int32 MaxSteps = URaceSettings::Get()->MaxRaceLogicStepsPerFrame;
+
+    Accumulator += DeltaTime;
+
+#if RACE_MALLOC_COUNTER
+    FRaceMallocScope MallocScope;
+#endif
+
+    // notes: frame arena; everything allocated on FMemStack during the steps is released here
+    int32 Steps = 0;
+    {
+        FMemMark FrameMark(FMemStack::Get());
+        while (Accumulator >= StepSeconds && Steps < MaxSteps)
+        {
+            Step(StepSeconds);
+            Accumulator -= StepSeconds;
+            ++Steps;
+        }
+    }
+
+#if RACE_MALLOC_COUNTER
+    LastTickMallocs = MallocScope.GetCount();
+    if (LastTickMallocs > 0 && RaceMallocCounter::ShouldLogFrames())
+    {
+        UE_LOG(LogTemp, Log, TEXT("[RaceLogic] %u heap allocation(s) in %d step(s), step %llu"), LastTickMallocs, Steps, StepCount);
+    }
+#endif
+
+    // notes: after a long hitch drop the backlog rather than stepping forever; only derived
+    //        work is lost, the race clock is read off world time (ARaceGameState::FixedRaceTick)
+    if (Accumulator >= StepSeconds)
+    {
+        Accumulator = FMath::Fmod(Accumulator, StepSeconds);
+    }
+
+    Alpha = Accumulator / StepSeconds;
+}
+
+void URaceLogicSubsystem::Step(float StepSeconds)
+{
+    ++StepCount;
+
+    ARaceGameState* GS = GetWorld()->GetGameState<ARaceGameState>();
+    if (GS)
+    {
+        GS->FixedRaceTick(StepSeconds, StepCount);
+    }
+
+    if (const URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>())
+    {
+        for (AMyCar* Car : Vehicles->GetCars())
+        {
+            if (IsValid(Car))
+            {
+                Car->FixedRaceTick(StepSeconds);
+            }
+        }
+
+        if (GS && GS->HasAuthority())
+        {
+            UpdateTrackLimits(*GS, Vehicles->GetCars(), StepSeconds);
+        }
+    }
+
+    // --- car snapshot for this step; ranking / stats run on a worker ---
+    if (URaceAnalyticsSubsystem* Analytics = GetWorld()->GetSubsystem<URaceAnalyticsSubsystem>())
+    {
+        Analytics->PublishSnapshot(StepCount);
+    }
+}
+
+void URaceLogicSubsystem::UpdateTrackLimits(const ARaceGameState& GS, const TArray<AMyCar*>& Cars, float StepSeconds)
+{
+    const URaceTrackData* Track = GS.GetTrackData();
+    if (!URaceSettings::Get()->bTrackLimits || !Track || !Track->TrackLimits.IsValid())
+    {
+        return;
+    }
+
+    // notes: proxy-sim cars are moved along the line and cannot leave it
+    for (AMyCar* Car : Cars)
+    {
+        if (IsValid(Car) && !Car->IsCrashed() && Car->GetSimLOD() != ERaceSimLOD::Proxy)
+        {
+            Car->UpdateTrackLimits(Track->TrackLimits.Sample(Car->GetActorLocation()), StepSeconds);
+        }
+    }
+}
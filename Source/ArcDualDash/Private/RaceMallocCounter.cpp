@@ -0,0 +1,135 @@
+// ============================================================================
+// RaceMallocCounter.cpp
+// notes: the wrapper forwards every call unchanged; the only extra work on
+//        an allocation is one thread-local test (plus an increment inside a
+//        scope), so it can stay installed for a whole session.
+// ============================================================================
+#include "RaceMallocCounter.h"
+
+#if RACE_MALLOC_COUNTER
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+
+namespace RaceMallocCounter
+{
+    static thread_local uint32 GScopeDepth = 0;
+    static thread_local uint32 GThreadMallocs = 0;
+
+    static FMalloc* GCountingMalloc = nullptr;
+
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { Note(); return Inner->Malloc(Count, Alignment); }
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { Note(); return Inner->TryMalloc(Count, Alignment); }
+
+        // notes: Realloc(nullptr, N) is an allocation, Realloc(P, 0) a free; a resize counts as one
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                Note();
+            }
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                Note();
+            }
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+
+        // --- everything else is the wrapped allocator's ---
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual void OnMallocInitialized() override { Inner->OnMallocInitialized(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        static FORCEINLINE void Note()
+        {
+            if (GScopeDepth > 0)
+            {
+                ++GThreadMallocs;
+            }
+        }
+
+        FMalloc* Inner;
+    };
+
+    bool Install()
+    {
+#if PLATFORM_USES_FIXED_GMalloc_CLASS
+        return false;
+#else
+        check(IsInGameThread());
+        if (!GCountingMalloc)
+        {
+            // notes: never freed; allocations made before the swap are freed through it too.
+            //        Published with a full barrier: workers may be allocating right now.
+            FMalloc* Inner = GMalloc;
+            GCountingMalloc = new FCountingMalloc(Inner);
+            FPlatformAtomics::InterlockedExchangePtr((void**)&GMalloc, GCountingMalloc);
+            UE_LOG(LogTemp, Log, TEXT("[MallocCounter] Counting race tick allocations (wrapping %s)"), Inner->GetDescriptiveName());
+        }
+        return true;
+#endif
+    }
+
+    bool IsInstalled()
+    {
+        return GCountingMalloc != nullptr;
+    }
+
+    static TAutoConsoleVariable<int32> CVarRaceMallocCounter(
+        TEXT("race.MallocCounter"),
+        0,
+        TEXT("Count heap allocations in the race logic tick. 1 = count (URaceLogicSubsystem::GetLastTickMallocs), 2 = also log frames that allocated. Start with -RaceMallocCounter to install the counter at startup. Not in Shipping."),
+        FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Var)
+        {
+            if (Var->GetInt() > 0 && !Install())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[MallocCounter] This platform bypasses GMalloc; allocations cannot be counted"));
+            }
+        }),
+        ECVF_Cheat);
+
+    bool ShouldLogFrames()
+    {
+        return CVarRaceMallocCounter.GetValueOnGameThread() >= 2;
+    }
+}
+
+FRaceMallocScope::FRaceMallocScope()
+    : StartCount(RaceMallocCounter::GThreadMallocs)
+{
+    ++RaceMallocCounter::GScopeDepth;
+}
+
+FRaceMallocScope::~FRaceMallocScope()
+{
+    --RaceMallocCounter::GScopeDepth;
+}
+
+uint32 FRaceMallocScope::GetCount() const
+{
+    return RaceMallocCounter::GThreadMallocs - StartCount;
+}
+
+#endif // RACE_MALLOC_COUNTER
@@ -0,0 +1,89 @@
+// ============================================================================
+// RaceMemory.cpp
+// notes: tag amounts are LLM's per-frame totals, so the report reflects the
+//        end of the previous frame. Without -llm it only says so.
+// ============================================================================
+#include "RaceMemory.h"
+#include "RaceSettings.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+LLM_DEFINE_TAG(Race);
+LLM_DEFINE_TAG(Race_State, TEXT("State"), TEXT("Race"));
+LLM_DEFINE_TAG(Race_Leaderboard, TEXT("Leaderboard"), TEXT("Race"));
+LLM_DEFINE_TAG(Race_Collectables, TEXT("Collectables"), TEXT("Race"));
+LLM_DEFINE_TAG(Race_HUD, TEXT("HUD"), TEXT("Race"));
+LLM_DEFINE_TAG(Race_Vehicles, TEXT("Vehicles"), TEXT("Race"));
+LLM_DEFINE_TAG(Race_Replay, TEXT("Replay"), TEXT("Race"));
+
+int32 RaceMemory::PrintReport(FOutputDevice& Ar)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    FLowLevelMemTracker& LLM = FLowLevelMemTracker::Get();
+    if (!LLM.IsEnabled())
+    {
+        Ar.Log(TEXT("[RaceMem] LLM is off; run with -llm to track race memory"));
+        return 0;
+    }
+
+    const URaceSettings* Settings = URaceSettings::Get();
+
+    struct FRow
+    {
+        FName Tag;
+        const TCHAR* Label;
+        float BudgetMB;
+    };
+    const FRow Rows[] =
+    {
+        { LLMTagDeclaration_Race_State.GetUniqueName(),        TEXT("State"),        Settings->RaceStateBudgetMB },
+        { LLMTagDeclaration_Race_Leaderboard.GetUniqueName(),  TEXT("Leaderboard"),  Settings->LeaderboardBudgetMB },
+        { LLMTagDeclaration_Race_Collectables.GetUniqueName(), TEXT("Collectables"), Settings->CollectablesBudgetMB },
+        { LLMTagDeclaration_Race_HUD.GetUniqueName(),          TEXT("HUD"),          Settings->HUDBudgetMB },
+        { LLMTagDeclaration_Race_Vehicles.GetUniqueName(),     TEXT("Vehicles"),     Settings->VehiclesBudgetMB },
+        { LLMTagDeclaration_Race_Replay.GetUniqueName(),       TEXT("Replay"),       Settings->ReplayBudgetMB },
+    };
+
+    Ar.Log(TEXT("[RaceMem] ---- race memory (LLM default tracker) ----"));
+    Ar.Logf(TEXT("[RaceMem] %-14s %10s %10s %6s"), TEXT("Tag"), TEXT("Used MB"), TEXT("Budget MB"), TEXT("%"));
+
+    int32 NumOver = 0;
+    double TotalMB = 0.0;
+    for (const FRow& Row : Rows)
+    {
+        const int64 Bytes = LLM.GetTagAmountForTracker(ELLMTracker::Default, Row.Tag, ELLMTagSet::None);
+        const double UsedMB = Bytes / (1024.0 * 1024.0);
+        TotalMB += UsedMB;
+
+        if (Row.BudgetMB <= 0.f)
+        {
+            Ar.Logf(TEXT("[RaceMem] %-14s %10.2f %10s"), Row.Label, UsedMB, TEXT("-"));
+            continue;
+        }
+
+        const double Percent = 100.0 * UsedMB / Row.BudgetMB;
+        if (UsedMB > Row.BudgetMB)
+        {
+            ++NumOver;
+            Ar.Logf(ELogVerbosity::Warning, TEXT("[RaceMem] %-14s %10.2f %10.2f %5.0f%%  OVER BUDGET"),
+                Row.Label, UsedMB, Row.BudgetMB, Percent);
+        }
+        else
+        {
+            Ar.Logf(TEXT("[RaceMem] %-14s %10.2f %10.2f %5.0f%%"), Row.Label, UsedMB, Row.BudgetMB, Percent);
+        }
+    }
+
+    Ar.Logf(TEXT("[RaceMem] %-14s %10.2f   (%d over budget)"), TEXT("Total"), TotalMB, NumOver);
+    return NumOver;
+#else
+    Ar.Log(TEXT("[RaceMem] LLM is compiled out of this build"));
+    return 0;
+#endif
+}
+
+static FAutoConsoleCommandWithOutputDevice GRaceMemReportCommand(
+    TEXT("race.MemReport"),
+    TEXT("Print race system memory (LLM tags) against the budgets in Project Settings -> Race -> Memory."),
+    FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar) { RaceMemory::PrintReport(Ar); }));
@@ -6,14 +6,21 @@
 // ============================================================================
 
 #include "RacePlayerController.h"
+#include "RaceMemory.h"
 #include "MyCar.h"
+#include "RaceSettings.h"
+#include "RaceStartupSubsystem.h"
+#include "RaceStreamingSubsystem.h"
+#include "SRaceMinimap.h"
 
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintGeneratedClass.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/LocalPlayer.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/ScopeExit.h"
 #include "TimerManager.h"
+#include "Widgets/Layout/SBox.h"
 
 // ============================================================================
 // Constructor / BeginPlay
@@ -36,9 +43,35 @@ void ARacePlayerController::BeginPlay()
             PlayerIndex = LP->GetControllerId() + 1; // 1-based for display
             UE_LOG(LogTemp, Log, TEXT("[RacePC] Assigned PlayerIndex = %d for %s"), PlayerIndex, *GetName());
         }
+        else if (HasAuthority())
+        {
+            // remote client on a listen/dedicated server: number by join order
+            PlayerIndex = GetWorld()->GetNumPlayerControllers();
+            UE_LOG(LogTemp, Log, TEXT("[RacePC] Assigned remote PlayerIndex = %d for %s"), PlayerIndex, *GetName());
+        }
     }
 
-    SpawnLocalHUD();
+    // remote controllers on a server have no viewport to draw into
+    if (IsLocalController())
+    {
+        // track-progress sources replace the camera-radius one (World Partition maps only)
+        const URaceStreamingSubsystem* Streaming = GetWorld()->GetSubsystem<URaceStreamingSubsystem>();
+        if (Streaming && Streaming->IsProvidingStreaming())
+        {
+            bEnableStreamingSource = false;
+        }
+
+        // network clients have no game mode to start the preload (ARaceGameMode::StartPlay); once per world
+        if (!GetWorld()->GetAuthGameMode())
+        {
+            if (URaceStartupSubsystem* Startup = URaceStartupSubsystem::Get(this))
+            {
+                Startup->BeginRacePreload(GetWorld());
+            }
+        }
+
+        SpawnLocalHUD();
+    }
 }
 
 // ============================================================================
@@ -46,82 +79,133 @@ void ARacePlayerController::BeginPlay()
 // ============================================================================
 void ARacePlayerController::SpawnLocalHUD()
 {
-    FTimerHandle H;
-    GetWorldTimerManager().SetTimer(H, [this]()
+    // notes: HUD waits for the race preload instead of a fixed delay; the ready
+    //        callback runs a tick after preload so our pawn is possessed by then
+    if (URaceStartupSubsystem* Startup = URaceStartupSubsystem::Get(this))
+    {
+        Startup->CallWhenRaceReady(FSimpleDelegate::CreateUObject(this, &ARacePlayerController::CreateLocalHUD));
+    }
+    else
+    {
+        CreateLocalHUD();
+    }
+}
+
+void ARacePlayerController::CreateLocalHUD()
+{
+    LLM_SCOPE_BYTAG(Race_HUD);
+
+    // notes: report even on failure so green light never waits on a broken HUD
+    ON_SCOPE_EXIT
+    {
+        if (URaceStartupSubsystem* Startup = URaceStartupSubsystem::Get(this))
         {
-            ULocalPlayer* LP = GetLocalPlayer();
-            UGameViewportClient* GVC = GetWorld() ? GetWorld()->GetGameViewport() : nullptr;
+            Startup->NotifyHUDCreated(GetLocalPlayer());
+        }
+    };
 
-            // --- Ensure PlayerIndex is valid (late correction) ---
-            if (PlayerIndex == 0 && LP)
-            {
-                PlayerIndex = LP->GetControllerId() + 1;
-                UE_LOG(LogTemp, Log, TEXT("[RacePC] Late PlayerIndex correction = %d for %s"), PlayerIndex, *GetName());
-            }
+    ULocalPlayer* LP = GetLocalPlayer();
+    UGameViewportClient* GVC = GetWorld() ? GetWorld()->GetGameViewport() : nullptr;
 
-            if (!HUDWidgetClass)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[RacePC] HUDWidgetClass is null on %s"), *GetName());
-                return;
-            }
-            if (!LP || !GVC)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[RacePC] Missing LocalPlayer/GameViewport on %s"), *GetName());
-                return;
-            }
+    // --- Ensure PlayerIndex is valid (late correction) ---
+    if (PlayerIndex == 0 && LP)
+    {
+        PlayerIndex = LP->GetControllerId() + 1;
+        UE_LOG(LogTemp, Log, TEXT("[RacePC] Late PlayerIndex correction = %d for %s"), PlayerIndex, *GetName());
+    }
 
-            // --- Create widget instance ---
-            UUserWidget* W = CreateWidget<UUserWidget>(this, HUDWidgetClass);
-            if (!W)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[RacePC] CreateWidget failed on %s"), *GetName());
-                return;
-            }
-            W->SetOwningPlayer(this);
+    if (LP && GVC)
+    {
+        CreateMinimap(LP, GVC);
+    }
 
-            // --- Automatically assign OwningCar variable in the BP widget ---
-            if (AMyCar* MyCar = Cast<AMyCar>(GetPawn()))
-            {
-                if (UWidgetBlueprintGeneratedClass* WidgetBPClass = Cast<UWidgetBlueprintGeneratedClass>(W->GetClass()))
-                {
-                    if (FObjectPropertyBase* Prop = FindFProperty<FObjectPropertyBase>(WidgetBPClass, FName(TEXT("OwningCar"))))
-                    {
-                        Prop->SetObjectPropertyValue_InContainer(W, MyCar);
-                        UE_LOG(LogTemp, Log, TEXT("[RacePC] Assigned OwningCar = %s for %s"), *MyCar->GetName(), *GetName());
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("[RacePC] Could not find 'OwningCar' variable in %s"), *W->GetName());
-                    }
-                }
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[RacePC] No MyCar pawn found for %s"), *GetName());
-            }
+    if (!HUDWidgetClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[RacePC] HUDWidgetClass is null on %s"), *GetName());
+        return;
+    }
+    if (!LP || !GVC)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[RacePC] Missing LocalPlayer/GameViewport on %s"), *GetName());
+        return;
+    }
 
-            // --- Add to correct split-screen region ---
-            GVC->AddViewportWidgetForPlayer(LP, W->TakeWidget(), /*ZOrder=*/100);
-            HUDWidgetInstance = W;
+    // --- Create widget instance ---
+    UUserWidget* W = CreateWidget<UUserWidget>(this, HUDWidgetClass);
+    if (!W)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[RacePC] CreateWidget failed on %s"), *GetName());
+        return;
+    }
+    W->SetOwningPlayer(this);
 
-            // --- Adjust screen position depending on player ---
-            const int32 ControllerId = LP->GetControllerId();
-            if (ControllerId == 0)
+    // --- Automatically assign OwningCar variable in the BP widget ---
+    if (AMyCar* MyCar = Cast<AMyCar>(GetPawn()))
+    {
+        if (UWidgetBlueprintGeneratedClass* WidgetBPClass = Cast<UWidgetBlueprintGeneratedClass>(W->GetClass()))
+        {
+            if (FObjectPropertyBase* Prop = FindFProperty<FObjectPropertyBase>(WidgetBPClass, FName(TEXT("OwningCar"))))
             {
-                W->SetAnchorsInViewport(FAnchors(0.5f, 0.f, 0.5f, 0.f));
-                W->SetAlignmentInViewport(FVector2D(0.5f, 0.f));
-                W->SetPositionInViewport(FVector2D(0.f, 16.f), false);
+                Prop->SetObjectPropertyValue_InContainer(W, MyCar);
+                UE_LOG(LogTemp, Log, TEXT("[RacePC] Assigned OwningCar = %s for %s"), *MyCar->GetName(), *GetName());
             }
             else
             {
-                W->SetAnchorsInViewport(FAnchors(0.5f, 1.f, 0.5f, 1.f));
-                W->SetAlignmentInViewport(FVector2D(0.5f, 1.f));
-                W->SetPositionInViewport(FVector2D(0.f, -16.f), false);
+                UE_LOG(LogTemp, Warning, TEXT("[RacePC] Could not find 'OwningCar' variable in %s"), *W->GetName());
             }
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[RacePC] No MyCar pawn found for %s"), *GetName());
+    }
+
+    // --- Add to correct split-screen region ---
+    GVC->AddViewportWidgetForPlayer(LP, W->TakeWidget(), /*ZOrder=*/100);
+    HUDWidgetInstance = W;
+
+    // --- Adjust screen position depending on player ---
+    const int32 ControllerId = LP->GetControllerId();
+    if (ControllerId == 0)
+    {
+        W->SetAnchorsInViewport(FAnchors(0.5f, 0.f, 0.5f, 0.f));
+        W->SetAlignmentInViewport(FVector2D(0.5f, 0.f));
+        W->SetPositionInViewport(FVector2D(0.f, 16.f), false);
+    }
+    else
+    {
+        W->SetAnchorsInViewport(FAnchors(0.5f, 1.f, 0.5f, 1.f));
+        W->SetAlignmentInViewport(FVector2D(0.5f, 1.f));
+        W->SetPositionInViewport(FVector2D(0.f, -16.f), false);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[RacePC] HUD added for ControllerId=%d"), ControllerId);
+}
+
+// ============================================================================
+// Minimap (native Slate, drawn from race data; no scene capture)
+// ============================================================================
+void ARacePlayerController::CreateMinimap(ULocalPlayer* LP, UGameViewportClient* GVC)
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+    if (!Settings->bShowMinimap || Minimap.IsValid())
+    {
+        return;
+    }
 
-            UE_LOG(LogTemp, Log, TEXT("[RacePC] HUD added for ControllerId=%d"), ControllerId);
-        },
-        0.10f, false);
+    // notes: top-right of this player's pane; the HUD widget sits top / bottom centre
+    GVC->AddViewportWidgetForPlayer(LP,
+        SNew(SBox)
+        .HAlign(HAlign_Right)
+        .VAlign(VAlign_Top)
+        .Padding(16.f)
+        [
+            SAssignNew(Minimap, SRaceMinimap)
+            .OwningPlayer(this)
+            .Size(Settings->MinimapSize)
+            .MarkerSize(Settings->MinimapMarkerSize)
+        ],
+        /*ZOrder=*/90);
 }
 
 // ============================================================================
@@ -0,0 +1,8 @@
+#include "RacePreloadData.h"
+#include "RaceSettings.h"
+
+FPrimaryAssetId URacePreloadData::GetPrimaryAssetId() const
+{
+    // notes: type comes from settings so DefaultGame.ini scan rule and asset id always agree
+    return FPrimaryAssetId(FPrimaryAssetType(URaceSettings::Get()->PreloadAssetType), GetFName());
+}
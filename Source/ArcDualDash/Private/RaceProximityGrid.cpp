@@ -0,0 +1,41 @@
+// ============================================================================
+// RaceProximityGrid.cpp
+// notes: counting-sort style build: bucket sizes first, then one scatter pass;
+//        arrays keep their capacity between frames.
+// ============================================================================
+#include "RaceProximityGrid.h"
+
+void FRaceProximityGrid::Build(TConstArrayView<FVector> Positions, float InCellSize)
+{
+    InvCellSize = 1.f / FMath::Max(InCellSize, 1.f);
+
+    const int32 Count = Positions.Num();
+    EntryCells.SetNumUninitialized(Count, EAllowShrinking::No);
+    SortedIndices.SetNumUninitialized(Count, EAllowShrinking::No);
+    CellRanges.Reset();
+
+    // --- pass 1: cell per entry + count per cell ---
+    for (int32 i = 0; i < Count; ++i)
+    {
+        EntryCells[i] = ToCell(Positions[i]);
+        FIntPoint& Range = CellRanges.FindOrAdd(EntryCells[i], FIntPoint(0, 0));
+        ++Range.Y;
+    }
+
+    // --- prefix sum: start offsets, reset counts for the scatter ---
+    int32 Start = 0;
+    for (TPair<FIntPoint, FIntPoint>& Pair : CellRanges)
+    {
+        Pair.Value.X = Start;
+        Start += Pair.Value.Y;
+        Pair.Value.Y = 0;
+    }
+
+    // --- pass 2: scatter ---
+    for (int32 i = 0; i < Count; ++i)
+    {
+        FIntPoint& Range = CellRanges.FindChecked(EntryCells[i]);
+        SortedIndices[Range.X + Range.Y] = i;
+        ++Range.Y;
+    }
+}
@@ -0,0 +1,320 @@
+// ============================================================================
+// RaceReplaySubsystem.cpp
+// notes: recording samples each local car's DriveInput at the end of the frame
+//        (after input has been processed); replay applies it at the start of
+//        the same frame index, i.e. before that frame's vehicle / physics tick.
+//        Only the first map loaded after startup is recorded / replayed.
+// ============================================================================
+#include "RaceReplaySubsystem.h"
+#include "RaceMemory.h"
+#include "RaceSettings.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace RaceReplay
+{
+    constexpr uint32 Magic = 0x52435241; // "ARCR"
+    constexpr uint32 Version = 1;
+
+    static bool SameInput(const FRaceDriveInput& A, const FRaceDriveInput& B)
+    {
+        return A.Throttle == B.Throttle && A.Steering == B.Steering && A.Brake == B.Brake && A.bHandbrake == B.bHandbrake;
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FRaceReplayEvent& Event)
+{
+    uint8 bHandbrake = Event.Input.bHandbrake ? 1 : 0;
+    Ar << Event.Frame << Event.Slot << Event.Input.Throttle << Event.Input.Steering << Event.Input.Brake << bHandbrake;
+    Event.Input.bHandbrake = bHandbrake != 0;
+    return Ar;
+}
+
+URaceReplaySubsystem* URaceReplaySubsystem::Get(const UObject* WorldContext)
+{
+    const UGameInstance* GI = UGameplayStatics::GetGameInstance(WorldContext);
+    return GI ? GI->GetSubsystem<URaceReplaySubsystem>() : nullptr;
+}
+
+bool URaceReplaySubsystem::IsReplaying(const UObject* WorldContext)
+{
+    const URaceReplaySubsystem* Replay = Get(WorldContext);
+    return Replay && Replay->bActive && Replay->Mode == EMode::Replay;
+}
+
+FString URaceReplaySubsystem::ResolvePath(const FString& Name)
+{
+    FString Path = FPaths::IsRelative(Name) ? FPaths::ProjectSavedDir() / TEXT("Replays") / Name : Name;
+    if (FPaths::GetExtension(Path).IsEmpty())
+    {
+        Path += TEXT(".rrec");
+    }
+    return Path;
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+bool URaceReplaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    FString Unused;
+    return Super::ShouldCreateSubsystem(Outer)
+        && (FParse::Value(FCommandLine::Get(), TEXT("RaceRecord="), Unused)
+            || FParse::Value(FCommandLine::Get(), TEXT("RaceReplay="), Unused));
+}
+
+void URaceReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    FString Name;
+    if (FParse::Value(FCommandLine::Get(), TEXT("RaceReplay="), Name))
+    {
+        Mode = EMode::Replay;
+        FilePath = ResolvePath(Name);
+        bUnpaced = FParse::Param(FCommandLine::Get(), TEXT("RaceReplayUnpaced"));
+        if (!LoadRecording())
+        {
+            return;
+        }
+    }
+    else
+    {
+        FParse::Value(FCommandLine::Get(), TEXT("RaceRecord="), Name);
+        Mode = EMode::Record;
+        FilePath = ResolvePath(Name);
+        FixedDeltaTime = 1.f / URaceSettings::Get()->ReplayFrameRate;
+        if (!FParse::Value(FCommandLine::Get(), TEXT("RaceSeed="), Seed))
+        {
+            Seed = (int32)(FPlatformTime::Cycles() & 0x7fffffff);
+        }
+    }
+
+    ApplyTimeStep();
+
+    PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &URaceReplaySubsystem::HandlePreLoadMap);
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &URaceReplaySubsystem::HandlePostLoadMap);
+    BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &URaceReplaySubsystem::HandleBeginFrame);
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &URaceReplaySubsystem::HandleEndFrame);
+}
+
+void URaceReplaySubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+    if (bActive && Mode == EMode::Record)
+    {
+        SaveRecording();
+    }
+    bActive = false;
+
+    Super::Deinitialize();
+}
+
+void URaceReplaySubsystem::ApplyTimeStep() const
+{
+    // notes: paced fixed frame rate; unpaced replay drops the wall-clock wait
+    GEngine->bUseFixedFrameRate = true;
+    GEngine->FixedFrameRate = 1.f / FixedDeltaTime;
+
+    if (bUnpaced)
+    {
+        FApp::SetUseFixedTimeStep(true);
+        FApp::SetFixedDeltaTime(FixedDeltaTime);
+    }
+}
+
+void URaceReplaySubsystem::HandlePreLoadMap(const FString& InMapName)
+{
+    if (!bActive)
+    {
+        return;
+    }
+
+    if (Mode == EMode::Record)
+    {
+        SaveRecording();
+    }
+    bActive = false;
+}
+
+void URaceReplaySubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    // notes: first map only; Events are empty in record mode / loaded in replay mode
+    if (!LoadedWorld || bActive || Frame > 0)
+    {
+        return;
+    }
+
+    const FString LoadedMap = UWorld::RemovePIEPrefix(LoadedWorld->GetOutermost()->GetName());
+    if (Mode == EMode::Replay && LoadedMap != MapName)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[Replay] %s was recorded on %s, playing on %s"), *FilePath, *MapName, *LoadedMap);
+    }
+    MapName = LoadedMap;
+
+    FMath::RandInit(Seed);
+    FMath::SRandInit(Seed);
+
+    Cursor = 0;
+    Frame = 0;
+    for (int32 i = 0; i < MaxSlots; ++i)
+    {
+        bHasLastInput[i] = false;
+    }
+    bActive = true;
+
+    UE_LOG(LogTemp, Log, TEXT("[Replay] %s %s on %s (seed %d, %.1f Hz)"),
+        Mode == EMode::Record ? TEXT("Recording") : TEXT("Replaying"), *FilePath, *MapName, Seed, 1.f / FixedDeltaTime);
+}
+
+// ============================================================================
+// Per frame
+// ============================================================================
+void URaceReplaySubsystem::HandleBeginFrame()
+{
+    if (bActive && Mode == EMode::Replay)
+    {
+        PlayFrame();
+    }
+}
+
+void URaceReplaySubsystem::HandleEndFrame()
+{
+    if (!bActive)
+    {
+        return;
+    }
+
+    if (Mode == EMode::Record)
+    {
+        CaptureFrame();
+    }
+    ++Frame;
+
+    if (Mode == EMode::Replay && Frame >= NumRecordedFrames)
+    {
+        bActive = false;
+        UE_LOG(LogTemp, Log, TEXT("[Replay] Finished %s after %u frames"), *FilePath, Frame);
+        if (URaceSettings::Get()->bQuitAfterReplay)
+        {
+            FPlatformMisc::RequestExit(/*bForce*/false, TEXT("RaceReplay"));
+        }
+    }
+}
+
+AMyCar* URaceReplaySubsystem::GetLocalCar(int32 Slot) const
+{
+    const APlayerController* PC = UGameplayStatics::GetPlayerControllerFromID(GetGameInstance()->GetWorld(), Slot);
+    return PC ? Cast<AMyCar>(PC->GetPawn()) : nullptr;
+}
+
+void URaceReplaySubsystem::CaptureFrame()
+{
+    LLM_SCOPE_BYTAG(Race_Replay);
+
+    for (int32 Slot = 0; Slot < MaxSlots; ++Slot)
+    {
+        const AMyCar* Car = GetLocalCar(Slot);
+        if (!Car)
+        {
+            continue;
+        }
+
+        const FRaceDriveInput& Input = Car->GetDriveInput();
+        if (bHasLastInput[Slot] && RaceReplay::SameInput(Input, LastInput[Slot]))
+        {
+            continue;
+        }
+
+        FRaceReplayEvent& Event = Events.AddDefaulted_GetRef();
+        Event.Frame = Frame;
+        Event.Slot = (uint8)Slot;
+        Event.Input = Input;
+
+        LastInput[Slot] = Input;
+        bHasLastInput[Slot] = true;
+    }
+}
+
+void URaceReplaySubsystem::PlayFrame()
+{
+    while (Cursor < Events.Num() && Events[Cursor].Frame <= Frame)
+    {
+        const FRaceReplayEvent& Event = Events[Cursor++];
+        if (AMyCar* Car = GetLocalCar(Event.Slot))
+        {
+            Car->SetDriveInput(Event.Input);
+        }
+    }
+}
+
+// ============================================================================
+// File
+// ============================================================================
+bool URaceReplaySubsystem::SaveRecording()
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    uint32 Magic = RaceReplay::Magic;
+    uint32 Version = RaceReplay::Version;
+    uint32 NumFrames = Frame;
+    Ar << Magic << Version << Seed << FixedDeltaTime << MapName << NumFrames << Events;
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Replay] Could not write %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Replay] Saved %s: %u frames, %d input changes, %d bytes"),
+        *FilePath, NumFrames, Events.Num(), Bytes.Num());
+    return true;
+}
+
+bool URaceReplaySubsystem::LoadRecording()
+{
+    LLM_SCOPE_BYTAG(Race_Replay);
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Replay] Could not read %s"), *FilePath);
+        return false;
+    }
+
+    FMemoryReader Ar(Bytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    Ar << Magic << Version;
+    if (Magic != RaceReplay::Magic || Version != RaceReplay::Version)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Replay] %s is not a v%u race recording"), *FilePath, RaceReplay::Version);
+        return false;
+    }
+
+    Ar << Seed << FixedDeltaTime << MapName << NumRecordedFrames << Events;
+    if (Ar.IsError() || FixedDeltaTime <= 0.f)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Replay] %s is truncated"), *FilePath);
+        Events.Reset();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,382 @@
+// ============================================================================
+// RaceResultsSubsystem.cpp
+// notes: record append and index rewrite are two writes; the index is written
+//        to a temp file and moved over, so it is either the old or the new one.
+//        The history can only be ahead of the index, never behind.
+// ============================================================================
+#include "RaceResultsSubsystem.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceGameState.h"
+#include "RaceInstanceSubsystem.h"
+#include "RaceSettings.h"
+
+#include "Algo/BinarySearch.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace RaceResults
+{
+    constexpr uint32 DataMagic = 0x53525241;   // "ARRS"
+    constexpr uint32 IndexMagic = 0x49525241;  // "ARRI"
+    constexpr uint32 Version = 1;
+    constexpr int64 DataHeaderSize = 8;
+    constexpr int64 RecordSize = sizeof(FRaceResultRecord);
+
+    static FString ToString(const ANSICHAR* Text, int32 MaxLen)
+    {
+        // notes: names are not trusted to be terminated (hand-edited / torn files)
+        const FUTF8ToTCHAR Converted(Text, FCStringAnsi::Strnlen(Text, MaxLen));
+        return FString(Converted.Length(), Converted.Get());
+    }
+
+    static void CopyName(ANSICHAR* Dest, int32 DestSize, const FString& Name)
+    {
+        FCStringAnsi::Strncpy(Dest, TCHAR_TO_UTF8(*Name), DestSize);
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GRaceResultsCommand(
+    TEXT("race.Results"),
+    TEXT("Print the best race times stored for the current track. Arg: count (default 10)."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (const URaceResultsSubsystem* Results = URaceResultsSubsystem::Get(World))
+        {
+            Results->PrintTopResults(URaceResultsSubsystem::GetTrackName(World), Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10);
+        }
+    }));
+
+FArchive& operator<<(FArchive& Ar, FRaceResultEntry& Entry)
+{
+    Ar << Entry.PlayerName << Entry.CarName << Entry.RaceTime << Entry.BestLapTime << Entry.Date << Entry.RecordIndex;
+    return Ar;
+}
+
+// ============================================================================
+// Index
+// ============================================================================
+void URaceResultsSubsystem::FTrackIndex::Add(const FRaceResultRecord& Record, int64 RecordIndex, int32 MaxTop)
+{
+    FRaceResultEntry Entry;
+    Entry.PlayerName = RaceResults::ToString(Record.PlayerName, UE_ARRAY_COUNT(Record.PlayerName));
+    Entry.CarName = RaceResults::ToString(Record.CarName, UE_ARRAY_COUNT(Record.CarName));
+    Entry.RaceTime = Record.RaceTime;
+    Entry.BestLapTime = Record.BestLapTime;
+    Entry.Date = FDateTime::FromUnixTimestamp(Record.UnixTime);
+    Entry.RecordIndex = RecordIndex;
+
+    NumRecords = FMath::Max(NumRecords, RecordIndex + 1);
+
+    // --- top-N: sorted insert, drop the slowest ---
+    if (Top.Num() < MaxTop || Entry.RaceTime < Top.Last().RaceTime)
+    {
+        const int32 At = Algo::UpperBoundBy(Top, Entry.RaceTime, &FRaceResultEntry::RaceTime);
+        Top.Insert(Entry, At);
+        if (Top.Num() > MaxTop)
+        {
+            Top.Pop(EAllowShrinking::No);
+        }
+    }
+
+    // --- personal best per (player, car): best race, best lap from any race ---
+    FRaceResultEntry* Best = PersonalBests.Find(MakeKey(Entry.PlayerName, Entry.CarName));
+    if (!Best)
+    {
+        PersonalBests.Add(MakeKey(Entry.PlayerName, Entry.CarName), Entry);
+        return;
+    }
+
+    const float BestLap = Best->BestLapTime > 0.f && Entry.BestLapTime > 0.f
+        ? FMath::Min(Best->BestLapTime, Entry.BestLapTime)
+        : FMath::Max(Best->BestLapTime, Entry.BestLapTime);
+    if (Entry.RaceTime < Best->RaceTime)
+    {
+        *Best = Entry;
+    }
+    Best->BestLapTime = BestLap;
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+URaceResultsSubsystem* URaceResultsSubsystem::Get(const UObject* WorldContext)
+{
+    const UGameInstance* GI = UGameplayStatics::GetGameInstance(WorldContext);
+    return GI ? GI->GetSubsystem<URaceResultsSubsystem>() : nullptr;
+}
+
+void URaceResultsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &URaceResultsSubsystem::HandlePostLoadMap);
+}
+
+void URaceResultsSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+    // notes: pending appends are results the player already saw; let them land
+    IOPipe.WaitUntilEmpty();
+    Tracks.Reset();
+
+    Super::Deinitialize();
+}
+
+FString URaceResultsSubsystem::GetTrackName(const UWorld* World)
+{
+    return World ? FPaths::GetBaseFilename(UWorld::RemovePIEPrefix(World->GetOutermost()->GetName())) : FString();
+}
+
+void URaceResultsSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    // notes: load the index while the race is starting, not when the first car finishes
+    if (LoadedWorld && URaceSettings::Get()->bRecordResults && !URaceInstanceSubsystem::IsInstanceWorld(LoadedWorld))
+    {
+        FindOrLoadTrack(GetTrackName(LoadedWorld));
+    }
+}
+
+TSharedRef<URaceResultsSubsystem::FTrackStore> URaceResultsSubsystem::FindOrLoadTrack(const FString& Track)
+{
+    if (const TSharedRef<FTrackStore>* Existing = Tracks.Find(Track))
+    {
+        return *Existing;
+    }
+
+    LLM_SCOPE_BYTAG(Race_Replay);
+
+    const FString Dir = FPaths::ProjectSavedDir() / URaceSettings::Get()->ResultsDirectory;
+    TSharedRef<FTrackStore> Store = MakeShared<FTrackStore>();
+    Store->Track = Track;
+    Store->DataPath = Dir / Track + TEXT(".rres");
+    Store->IndexPath = Dir / Track + TEXT(".ridx");
+    Tracks.Add(Track, Store);
+
+    const int32 MaxTop = URaceSettings::Get()->ResultsTopN;
+    IOPipe.Launch(UE_SOURCE_LOCATION, [Store, MaxTop]() { LoadIndex(*Store, MaxTop); });
+    return Store;
+}
+
+TSharedPtr<const URaceResultsSubsystem::FTrackStore> URaceResultsSubsystem::FindLoadedTrack(const FString& Track) const
+{
+    const TSharedRef<FTrackStore>* Store = Tracks.Find(Track);
+    if (!Store || !(*Store)->bLoaded.load())
+    {
+        return nullptr;
+    }
+    return *Store;
+}
+
+// ============================================================================
+// Game thread API
+// ============================================================================
+void URaceResultsSubsystem::SubmitFinish(const AMyCar& Car, float RaceTime, int32 Position, int32 NumCars)
+{
+    const UWorld* World = Car.GetWorld();
+    const URaceSettings* Settings = URaceSettings::Get();
+    if (!World || !Settings->bRecordResults || URaceInstanceSubsystem::IsInstanceWorld(World))
+    {
+        return;
+    }
+
+    FRaceResultRecord Record;
+    Record.UnixTime = FDateTime::UtcNow().ToUnixTimestamp();
+    Record.RaceTime = RaceTime;
+    Record.BestLapTime = Car.BestLapTime;
+    Record.Laps = (uint16)FMath::Clamp(Car.Lap - 1, 0, 65535);
+    Record.Position = (uint8)FMath::Clamp(Position, 0, 255);
+    Record.NumCars = (uint8)FMath::Clamp(NumCars, 0, 255);
+    Record.bAI = Car.bIsAI ? 1 : 0;
+    RaceResults::CopyName(Record.PlayerName, UE_ARRAY_COUNT(Record.PlayerName), ARaceGameState::MakePlayerName(&Car));
+
+    FString CarName = Car.GetClass()->GetName();
+    CarName.RemoveFromEnd(TEXT("_C"));
+    RaceResults::CopyName(Record.CarName, UE_ARRAY_COUNT(Record.CarName), CarName);
+
+    const TSharedRef<FTrackStore> Store = FindOrLoadTrack(GetTrackName(World));
+    const int32 MaxTop = Settings->ResultsTopN;
+    IOPipe.Launch(UE_SOURCE_LOCATION, [Store, Record, MaxTop]() { AppendRecord(*Store, Record, MaxTop); });
+}
+
+bool URaceResultsSubsystem::GetTopResults(const FString& Track, int32 Count, TArray<FRaceResultEntry>& OutResults) const
+{
+    OutResults.Reset();
+    const TSharedPtr<const FTrackStore> Store = FindLoadedTrack(Track);
+    if (!Store)
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&Store->Lock);
+    const int32 Num = FMath::Min(Count, Store->Index.Top.Num());
+    OutResults.Append(Store->Index.Top.GetData(), FMath::Max(0, Num));
+    return true;
+}
+
+bool URaceResultsSubsystem::GetPersonalBest(const FString& Track, const FString& PlayerName, const FString& CarName, FRaceResultEntry& OutResult) const
+{
+    const TSharedPtr<const FTrackStore> Store = FindLoadedTrack(Track);
+    if (!Store)
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&Store->Lock);
+    const FRaceResultEntry* Best = Store->Index.PersonalBests.Find(MakeKey(PlayerName, CarName));
+    if (!Best)
+    {
+        return false;
+    }
+    OutResult = *Best;
+    return true;
+}
+
+void URaceResultsSubsystem::PrintTopResults(const FString& Track, int32 Count) const
+{
+    TArray<FRaceResultEntry> Results;
+    if (!GetTopResults(Track, Count, Results))
+    {
+        UE_LOG(LogTemp, Log, TEXT("[Results] %s: index not loaded"), *Track);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Results] ---- %s: top %d ----"), *Track, Results.Num());
+    for (int32 i = 0; i < Results.Num(); ++i)
+    {
+        const FRaceResultEntry& R = Results[i];
+        UE_LOG(LogTemp, Log, TEXT("[Results] %2d. %-12s %-16s %8.3fs  best lap %7.3fs  %s"),
+            i + 1, *R.PlayerName, *R.CarName, R.RaceTime, R.BestLapTime, *R.Date.ToString());
+    }
+}
+
+// ============================================================================
+// Pipe (worker thread): file access only happens here
+// ============================================================================
+void URaceResultsSubsystem::LoadIndex(FTrackStore& Store, int32 MaxTop)
+{
+    LLM_SCOPE_BYTAG(Race_Replay);
+
+    IFileManager& FileManager = IFileManager::Get();
+
+    FTrackIndex Index;
+    TArray<uint8> Bytes;
+    if (FFileHelper::LoadFileToArray(Bytes, *Store.IndexPath, FILEREAD_Silent))
+    {
+        FMemoryReader Ar(Bytes);
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        Ar << Magic << Version;
+        if (Magic == RaceResults::IndexMagic && Version == RaceResults::Version)
+        {
+            Ar << Index;
+        }
+        if (Ar.IsError() || Magic != RaceResults::IndexMagic || Version != RaceResults::Version)
+        {
+            Index = FTrackIndex();
+        }
+    }
+
+    // --- catch the index up with the history (only the records it does not cover) ---
+    const int64 DataSize = FileManager.FileSize(*Store.DataPath);
+    const int64 OnDisk = DataSize > RaceResults::DataHeaderSize ? (DataSize - RaceResults::DataHeaderSize) / RaceResults::RecordSize : 0;
+    if (Index.NumRecords > OnDisk)
+    {
+        Index = FTrackIndex(); // history was replaced; rebuild from scratch
+    }
+
+    const int64 FirstMissing = Index.NumRecords;
+    if (FirstMissing < OnDisk)
+    {
+        TUniquePtr<FArchive> Reader(FileManager.CreateFileReader(*Store.DataPath));
+        if (Reader)
+        {
+            Reader->Seek(RaceResults::DataHeaderSize + FirstMissing * RaceResults::RecordSize);
+            for (int64 i = FirstMissing; i < OnDisk && !Reader->IsError(); ++i)
+            {
+                FRaceResultRecord Record;
+                Reader->Serialize(&Record, RaceResults::RecordSize);
+                Index.Add(Record, i, MaxTop);
+            }
+        }
+    }
+
+    {
+        FScopeLock Lock(&Store.Lock);
+        Store.Index = MoveTemp(Index);
+    }
+    Store.bLoaded = true;
+
+    if (FirstMissing < OnDisk)
+    {
+        SaveIndex(Store);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Results] %s: %lld results (%lld indexed on load)"), *Store.Track, OnDisk, OnDisk - FirstMissing);
+}
+
+void URaceResultsSubsystem::AppendRecord(FTrackStore& Store, const FRaceResultRecord& Record, int32 MaxTop)
+{
+    LLM_SCOPE_BYTAG(Race_Replay);
+
+    IFileManager& FileManager = IFileManager::Get();
+    TUniquePtr<FArchive> Writer(FileManager.CreateFileWriter(*Store.DataPath, FILEWRITE_Append | FILEWRITE_AllowRead));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Results] Could not open %s"), *Store.DataPath);
+        return;
+    }
+
+    int64 Size = Writer->TotalSize();
+    if (Size < RaceResults::DataHeaderSize)
+    {
+        uint32 Magic = RaceResults::DataMagic;
+        uint32 Version = RaceResults::Version;
+        *Writer << Magic << Version;
+        Size = RaceResults::DataHeaderSize;
+    }
+
+    const int64 RecordIndex = (Size - RaceResults::DataHeaderSize) / RaceResults::RecordSize;
+    Writer->Serialize(const_cast<FRaceResultRecord*>(&Record), RaceResults::RecordSize);
+    const bool bWritten = Writer->Close() && !Writer->IsError();
+    if (!bWritten)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Results] Could not append to %s"), *Store.DataPath);
+        return;
+    }
+
+    {
+        FScopeLock Lock(&Store.Lock);
+        Store.Index.Add(Record, RecordIndex, MaxTop);
+    }
+    SaveIndex(Store);
+}
+
+bool URaceResultsSubsystem::SaveIndex(const FTrackStore& Store)
+{
+    TArray<uint8> Bytes;
+    {
+        FScopeLock Lock(&Store.Lock);
+        FMemoryWriter Ar(Bytes);
+        uint32 Magic = RaceResults::IndexMagic;
+        uint32 Version = RaceResults::Version;
+        Ar << Magic << Version << const_cast<FTrackIndex&>(Store.Index);
+    }
+
+    const FString TempPath = Store.IndexPath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Store.IndexPath, *TempPath, /*bReplace*/true))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Results] Could not write %s"), *Store.IndexPath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,13 @@
+// ============================================================================
+// RaceSettings.cpp
+// notes: defaults only; real values live in Config/DefaultGame.ini
+// ============================================================================
+#include "RaceSettings.h"
+
+URaceSettings::URaceSettings()
+{
+    CategoryName = TEXT("Game");
+    SectionName = TEXT("Race");
+
+    PreloadBundles.Add(TEXT("Race"));
+}
@@ -0,0 +1,210 @@
+// ============================================================================
+// RaceSignificanceSubsystem.cpp
+// notes: scores are refreshed at SignificanceUpdateInterval; objects only do
+//        work when their bucket actually changes.
+// ============================================================================
+#include "RaceSignificanceSubsystem.h"
+#include "Collectable.h"
+#include "MyCar.h"
+#include "RaceSettings.h"
+
+#include "NiagaraComponent.h"
+#include "Particles/ParticleSystemComponent.h"
+
+bool URaceSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URaceSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URaceSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// Registration
+// ============================================================================
+void URaceSignificanceSubsystem::RegisterCollectable(ACollectable* Collectable)
+{
+    if (Collectable)
+    {
+        Collectables.AddUnique(Collectable);
+    }
+}
+
+void URaceSignificanceSubsystem::UnregisterCollectable(ACollectable* Collectable)
+{
+    Collectables.RemoveSwap(Collectable);
+}
+
+void URaceSignificanceSubsystem::RegisterEmitter(UFXSystemComponent* Emitter)
+{
+    if (Emitter)
+    {
+        Emitters.AddUnique(Emitter);
+    }
+}
+
+void URaceSignificanceSubsystem::UnregisterEmitter(UFXSystemComponent* Emitter)
+{
+    Emitters.RemoveSwap(Emitter);
+}
+
+// ============================================================================
+// Scoring
+// ============================================================================
+float URaceSignificanceSubsystem::ScoreSphere(const FRaceViewpointArray& Viewpoints, const FVector& Center, float Radius)
+{
+    float Best = 0.f;
+
+    for (const FRaceViewpoint& View : Viewpoints)
+    {
+        const FVector ToObj = Center - View.Location;
+        const float Dist = ToObj.Size();
+        if (Dist <= Radius)
+        {
+            return 1.f; // camera inside the bounds
+        }
+
+        // --- cone test widened by the sphere's angular radius (and some room for aspect) ---
+        const float HalfFOV = FMath::DegreesToRadians(View.FOVDegrees * 0.5f);
+        const float Angle = FMath::Acos(FMath::Clamp(FVector::DotProduct(ToObj / Dist, View.Forward), -1.f, 1.f));
+        const float AngularRadius = FMath::Asin(Radius / Dist);
+        if (Angle - AngularRadius > HalfFOV * 1.3f)
+        {
+            continue;
+        }
+
+        // --- projected size as a fraction of this view's half-width ---
+        const float Score = Radius / (Dist * FMath::Tan(HalfFOV));
+        Best = FMath::Max(Best, Score);
+    }
+
+    return Best;
+}
+
+ERaceSignificance URaceSignificanceSubsystem::Classify(float Score)
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+
+    if (Score <= 0.f)
+        return ERaceSignificance::Hidden;
+    if (Score >= Settings->HighScreenSize)
+        return ERaceSignificance::High;
+    if (Score >= Settings->MediumScreenSize)
+        return ERaceSignificance::Medium;
+    return ERaceSignificance::Low;
+}
+
+float URaceSignificanceSubsystem::GetTickIntervalFor(ERaceSignificance Significance)
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+
+    switch (Significance)
+    {
+    case ERaceSignificance::Medium: return Settings->MediumTickInterval;
+    case ERaceSignificance::Low:    return Settings->LowTickInterval;
+    case ERaceSignificance::Hidden: return Settings->HiddenTickInterval;
+    default:                        return 0.f;
+    }
+}
+
+float URaceSignificanceSubsystem::GetFXSpawnScaleFor(ERaceSignificance Significance)
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+
+    switch (Significance)
+    {
+    case ERaceSignificance::Medium: return Settings->MediumFXSpawnScale;
+    case ERaceSignificance::Low:    return Settings->LowFXSpawnScale;
+    case ERaceSignificance::Hidden: return 0.f;
+    default:                        return 1.f;
+    }
+}
+
+bool URaceSignificanceSubsystem::ShouldSpawnFX(const FVector& Location, float Radius) const
+{
+    // notes: no views yet (first frames / server) -> don't second-guess the caller
+    if (CachedViewpoints.Num() == 0)
+    {
+        return true;
+    }
+    return Classify(ScoreSphere(CachedViewpoints, Location, Radius)) != ERaceSignificance::Hidden;
+}
+
+// ============================================================================
+// Update
+// ============================================================================
+void URaceSignificanceSubsystem::Tick(float DeltaTime)
+{
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate >= URaceSettings::Get()->SignificanceUpdateInterval)
+    {
+        TimeSinceUpdate = 0.f;
+        UpdateSignificance();
+    }
+}
+
+void URaceSignificanceSubsystem::UpdateSignificance()
+{
+    URaceVehicleSubsystem::GatherViewpoints(GetWorld(), CachedViewpoints);
+    if (CachedViewpoints.Num() == 0)
+    {
+        return;
+    }
+
+    // --- Cars ---
+    if (const URaceVehicleSubsystem* Vehicles = GetWorld()->GetSubsystem<URaceVehicleSubsystem>())
+    {
+        for (AMyCar* Car : Vehicles->GetCars())
+        {
+            if (!IsValid(Car) || !Car->GetMesh())
+                continue;
+
+            const FBoxSphereBounds& B = Car->GetMesh()->Bounds;
+            Car->ApplySignificance(Classify(ScoreSphere(CachedViewpoints, B.Origin, B.SphereRadius)));
+        }
+    }
+
+    // --- Collectables ---
+    for (ACollectable* Collectable : Collectables)
+    {
+        if (!IsValid(Collectable))
+            continue;
+
+        FVector Origin, Extent;
+        Collectable->GetActorBounds(/*bOnlyColliding*/false, Origin, Extent);
+        Collectable->ApplySignificance(Classify(ScoreSphere(CachedViewpoints, Origin, Extent.Size())));
+    }
+
+    // --- Pooled FX emitters ---
+    for (UFXSystemComponent* Emitter : Emitters)
+    {
+        if (!IsValid(Emitter) || !Emitter->IsActive())
+            continue;
+
+        const ERaceSignificance Sig = Classify(ScoreSphere(CachedViewpoints, Emitter->Bounds.Origin, Emitter->Bounds.SphereRadius));
+        ApplyEmitterSignificance(Emitter, Sig);
+    }
+}
+
+void URaceSignificanceSubsystem::ApplyEmitterSignificance(UFXSystemComponent* Emitter, ERaceSignificance Significance)
+{
+    // notes: a tick interval doesn't throttle Niagara (it simulates on its own world manager),
+    //        so cut the work itself: fewer particles spawned, nothing simulated off-screen
+    const bool bHidden = Significance == ERaceSignificance::Hidden;
+
+    // one-shots are detached in the pool: nobody sees them finish, stop spawning and let them die
+    if (bHidden && !Emitter->GetAttachParent())
+    {
+        Emitter->Deactivate();
+        return;
+    }
+
+    // looping trails follow a car: freeze while out of every view, resume where they were
+    if (UNiagaraComponent* Niagara = Cast<UNiagaraComponent>(Emitter))
+    {
+        Niagara->SetPaused(bHidden);
+    }
+    Emitter->SetFloatParameter(URaceSettings::Get()->FXSpawnScaleParameter, GetFXSpawnScaleFor(Significance));
+}
@@ -0,0 +1,337 @@
+// ============================================================================
+// RaceStartupSubsystem.cpp
+// notes: lives on the GameInstance so it survives map travel and can time the
+//        map load itself. Everything here is game-thread only.
+// ============================================================================
+#include "RaceStartupSubsystem.h"
+#include "RaceMemory.h"
+#include "RaceSettings.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Styling/CoreStyle.h"
+#include "TimerManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+
+static const TCHAR* GetPhaseName(ERaceStartupPhase Phase)
+{
+    switch (Phase)
+    {
+    case ERaceStartupPhase::MapLoad:        return TEXT("MapLoad");
+    case ERaceStartupPhase::ActorBeginPlay: return TEXT("ActorBeginPlay");
+    case ERaceStartupPhase::LocalPlayers:   return TEXT("LocalPlayers");
+    case ERaceStartupPhase::AssetPreload:   return TEXT("AssetPreload");
+    case ERaceStartupPhase::HUD:            return TEXT("HUD");
+    default:                                return TEXT("?");
+    }
+}
+
+URaceStartupSubsystem* URaceStartupSubsystem::Get(const UObject* WorldContext)
+{
+    const UGameInstance* GI = UGameplayStatics::GetGameInstance(WorldContext);
+    return GI ? GI->GetSubsystem<URaceStartupSubsystem>() : nullptr;
+}
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+void URaceStartupSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    Super::Initialize(Collection);
+
+    PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &URaceStartupSubsystem::HandlePreLoadMap);
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &URaceStartupSubsystem::HandlePostLoadMap);
+
+    ReportCommand = IConsoleManager::Get().RegisterConsoleCommand(
+        TEXT("race.StartupReport"),
+        TEXT("Print the last time-to-first-race-frame report."),
+        FConsoleCommandDelegate::CreateUObject(this, &URaceStartupSubsystem::PrintStartupReport),
+        ECVF_Default);
+}
+
+void URaceStartupSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+    if (ReportCommand)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(ReportCommand);
+        ReportCommand = nullptr;
+    }
+
+    HideLoadingScreen();
+    PreloadHandle.Reset();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// Phase timing
+// ============================================================================
+void URaceStartupSubsystem::BeginPhase(ERaceStartupPhase Phase)
+{
+    Phases[(int32)Phase].Start = FPlatformTime::Seconds();
+    Phases[(int32)Phase].End = 0.0;
+}
+
+void URaceStartupSubsystem::EndPhase(ERaceStartupPhase Phase)
+{
+    FPhaseTiming& T = Phases[(int32)Phase];
+    if (T.Start > 0.0)
+    {
+        T.End = FPlatformTime::Seconds();
+    }
+}
+
+void URaceStartupSubsystem::HandlePreLoadMap(const FString& MapName)
+{
+    // notes: new map -> new race; keep bIsColdStart so only the first report counts process start
+    for (FPhaseTiming& T : Phases)
+    {
+        T = FPhaseTiming();
+    }
+    PendingReadyCallbacks.Reset();
+    PlayersWithHUD.Reset();
+    PreloadHandle.Reset();
+    bPreloadDone = false;
+    bGreenLight = false;
+    CurrentMapName = FPackageName::GetShortName(MapName);
+
+    BeginPhase(ERaceStartupPhase::MapLoad);
+}
+
+void URaceStartupSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    EndPhase(ERaceStartupPhase::MapLoad);
+    if (LoadedWorld)
+    {
+        CurrentMapName = LoadedWorld->GetMapName();
+    }
+}
+
+// ============================================================================
+// Preload
+// ============================================================================
+void URaceStartupSubsystem::BeginRacePreload(UWorld* World)
+{
+    // notes: no LLM scope here; the streamed race assets are charged to their own asset tags
+    if (!World || PreloadWorld.Get() == World)
+    {
+        return;
+    }
+    PreloadWorld = World;
+    bPreloadDone = false;
+
+    const URaceSettings* Settings = URaceSettings::Get();
+    if (Settings->bShowLoadingScreen)
+    {
+        ShowLoadingScreen(World);
+    }
+
+    BeginPhase(ERaceStartupPhase::AssetPreload);
+
+    TArray<FPrimaryAssetId> AssetIds;
+    if (UAssetManager::IsInitialized())
+    {
+        UAssetManager::Get().GetPrimaryAssetIdList(FPrimaryAssetType(Settings->PreloadAssetType), AssetIds);
+    }
+    NumPreloadAssets = AssetIds.Num();
+
+    if (AssetIds.Num() == 0)
+    {
+        // notes: no URacePreloadData saved under /Game/Race yet -> first references still load synchronously
+        UE_LOG(LogTemp, Warning, TEXT("[Startup] No '%s' preload assets registered (add a RacePreloadData asset under /Game/Race); nothing to stream"),
+            *Settings->PreloadAssetType.ToString());
+        HandlePreloadComplete();
+        return;
+    }
+
+    // notes: handle is kept until next map so the bundles stay resident for the whole race
+    PreloadHandle = UAssetManager::Get().LoadPrimaryAssets(AssetIds, Settings->PreloadBundles,
+        FStreamableDelegate::CreateUObject(this, &URaceStartupSubsystem::HandlePreloadComplete),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    // notes: null handle == everything already resident (warm restart)
+    if (!PreloadHandle.IsValid() || PreloadHandle->HasLoadCompleted())
+    {
+        HandlePreloadComplete();
+    }
+}
+
+void URaceStartupSubsystem::HandlePreloadComplete()
+{
+    if (bPreloadDone)
+    {
+        return;
+    }
+    bPreloadDone = true;
+    EndPhase(ERaceStartupPhase::AssetPreload);
+    BeginPhase(ERaceStartupPhase::HUD);
+
+    UE_LOG(LogTemp, Log, TEXT("[Startup] Preloaded %d race asset(s)"), NumPreloadAssets);
+
+    // notes: always defer one tick -> pawns of freshly created local players are possessed by then
+    if (UWorld* World = PreloadWorld.Get())
+    {
+        World->GetTimerManager().SetTimerForNextTick(
+            FTimerDelegate::CreateUObject(this, &URaceStartupSubsystem::FlushReadyCallbacks));
+    }
+    else
+    {
+        FlushReadyCallbacks();
+    }
+}
+
+void URaceStartupSubsystem::CallWhenRaceReady(FSimpleDelegate Callback)
+{
+    PendingReadyCallbacks.Add(MoveTemp(Callback));
+
+    if (bPreloadDone)
+    {
+        if (UWorld* World = PreloadWorld.Get())
+        {
+            World->GetTimerManager().SetTimerForNextTick(
+                FTimerDelegate::CreateUObject(this, &URaceStartupSubsystem::FlushReadyCallbacks));
+        }
+    }
+}
+
+void URaceStartupSubsystem::FlushReadyCallbacks()
+{
+    TArray<FSimpleDelegate> Callbacks = MoveTemp(PendingReadyCallbacks);
+    PendingReadyCallbacks.Reset();
+
+    for (FSimpleDelegate& Callback : Callbacks)
+    {
+        Callback.ExecuteIfBound();
+    }
+
+    CheckGreenLight();
+}
+
+// ============================================================================
+// HUD / green light
+// ============================================================================
+void URaceStartupSubsystem::NotifyHUDCreated(const ULocalPlayer* LocalPlayer)
+{
+    if (LocalPlayer)
+    {
+        PlayersWithHUD.Add(LocalPlayer);
+    }
+    CheckGreenLight();
+}
+
+void URaceStartupSubsystem::CheckGreenLight()
+{
+    if (bGreenLight || !bPreloadDone)
+    {
+        return;
+    }
+
+    const int32 NumLocalPlayers = GetGameInstance() ? GetGameInstance()->GetNumLocalPlayers() : 0;
+    if (PlayersWithHUD.Num() < NumLocalPlayers)
+    {
+        return;
+    }
+
+    bGreenLight = true;
+    GreenLightTime = FPlatformTime::Seconds();
+    EndPhase(ERaceStartupPhase::HUD);
+    HideLoadingScreen();
+
+    PrintStartupReport();
+    bIsColdStart = false;
+
+    OnGreenLight.Broadcast();
+}
+
+void URaceStartupSubsystem::PrintStartupReport() const
+{
+    UE_LOG(LogTemp, Log, TEXT("[Startup] ---- time to first race frame: %s (%s) ----"),
+        *CurrentMapName, bIsColdStart ? TEXT("cold") : TEXT("warm"));
+
+    for (int32 i = 0; i < (int32)ERaceStartupPhase::MAX; ++i)
+    {
+        const FPhaseTiming& T = Phases[i];
+        if (T.Start > 0.0 && T.End >= T.Start)
+        {
+            UE_LOG(LogTemp, Log, TEXT("[Startup]   %-16s %8.1f ms"),
+                GetPhaseName((ERaceStartupPhase)i), (T.End - T.Start) * 1000.0);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Log, TEXT("[Startup]   %-16s      n/a"), GetPhaseName((ERaceStartupPhase)i));
+        }
+    }
+
+    if (!bGreenLight)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[Startup]   green light not reached yet"));
+        return;
+    }
+
+    // notes: cold = from process start (GStartTime), warm = from the map load request
+    const double From = bIsColdStart ? GStartTime : Phases[(int32)ERaceStartupPhase::MapLoad].Start;
+    const double Total = GreenLightTime - From;
+    const float Budget = URaceSettings::Get()->StartupBudgetSeconds;
+
+    if (Total > Budget)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[Startup]   TOTAL -> green light %.2f s  OVER budget %.2f s"), Total, Budget);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("[Startup]   TOTAL -> green light %.2f s  (budget %.2f s)"), Total, Budget);
+    }
+}
+
+// ============================================================================
+// Loading overlay (plain Slate, no asset needed so it shows before any load)
+// ============================================================================
+void URaceStartupSubsystem::ShowLoadingScreen(UWorld* World)
+{
+    LLM_SCOPE_BYTAG(Race_HUD);
+
+    UGameViewportClient* GVC = World ? World->GetGameViewport() : nullptr;
+    if (!GVC || LoadingWidget.IsValid())
+    {
+        return;
+    }
+
+    LoadingWidget = SNew(SBorder)
+        .BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+        .BorderBackgroundColor(FLinearColor::Black)
+        .HAlign(HAlign_Center)
+        .VAlign(VAlign_Center)
+        [
+            SNew(STextBlock)
+            .Text(NSLOCTEXT("Race", "LoadingRace", "Loading race..."))
+        ];
+
+    GVC->AddViewportWidgetContent(LoadingWidget.ToSharedRef(), /*ZOrder=*/1000);
+}
+
+void URaceStartupSubsystem::HideLoadingScreen()
+{
+    if (!LoadingWidget.IsValid())
+    {
+        return;
+    }
+
+    if (UGameViewportClient* GVC = GetGameInstance() ? GetGameInstance()->GetGameViewportClient() : nullptr)
+    {
+        GVC->RemoveViewportWidgetContent(LoadingWidget.ToSharedRef());
+    }
+    LoadingWidget.Reset();
+}
@@ -0,0 +1,195 @@
+// ============================================================================
+// RaceStreamingSubsystem.cpp
+// notes: sources are rebuilt at StreamingUpdateInterval and handed to World
+//        Partition as-is; priority drops with distance ahead so the cells the
+//        car reaches first are loaded first.
+// ============================================================================
+#include "RaceStreamingSubsystem.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceGameState.h"
+#include "RaceSettings.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+
+namespace RaceStreaming
+{
+    // notes: segments searched either side of the last known one
+    constexpr int32 SegmentSearchRadius = 3;
+}
+
+bool URaceStreamingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URaceStreamingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URaceStreamingSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// Registration
+// ============================================================================
+void URaceStreamingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // notes: nothing renders on a dedicated server; remote clients stream through their own PCs
+    if (!URaceSettings::Get()->bPredictiveStreaming
+        || !InWorld.GetWorldPartition()
+        || InWorld.GetNetMode() == NM_DedicatedServer)
+    {
+        return;
+    }
+
+    if (UWorldPartitionSubsystem* WPSubsystem = InWorld.GetSubsystem<UWorldPartitionSubsystem>())
+    {
+        WPSubsystem->RegisterStreamingSourceProvider(this);
+        bRegistered = true;
+        UE_LOG(LogTemp, Log, TEXT("[Streaming] Track-progress streaming sources active"));
+    }
+}
+
+void URaceStreamingSubsystem::Deinitialize()
+{
+    if (bRegistered)
+    {
+        if (UWorldPartitionSubsystem* WPSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+        {
+            WPSubsystem->UnregisterStreamingSourceProvider(this);
+        }
+        bRegistered = false;
+    }
+    Sources.Reset();
+    Players.Reset();
+
+    Super::Deinitialize();
+}
+
+bool URaceStreamingSubsystem::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+    OutStreamingSources.Append(Sources);
+    return Sources.Num() > 0;
+}
+
+// ============================================================================
+// Update
+// ============================================================================
+void URaceStreamingSubsystem::Tick(float DeltaTime)
+{
+    if (!bRegistered)
+    {
+        return;
+    }
+
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate >= URaceSettings::Get()->StreamingUpdateInterval)
+    {
+        TimeSinceUpdate = 0.f;
+        RebuildSources();
+    }
+}
+
+void URaceStreamingSubsystem::RebuildSources()
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    UWorld* World = GetWorld();
+    const ARaceGameState* GS = World->GetGameState<ARaceGameState>();
+    const URaceSettings* Settings = URaceSettings::Get();
+
+    // --- local players' cars (split-screen -> 2) ---
+    TArray<FTrackedPlayer, TInlineAllocator<4>> Current;
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PC = It->Get();
+        AMyCar* Car = (PC && PC->IsLocalController()) ? Cast<AMyCar>(PC->GetPawn()) : nullptr;
+        if (!Car)
+        {
+            continue;
+        }
+
+        FTrackedPlayer& Tracked = Current.AddDefaulted_GetRef();
+        Tracked.Car = Car;
+        if (const FTrackedPlayer* Previous = Players.FindByPredicate([Car](const FTrackedPlayer& P) { return P.Car.Get() == Car; }))
+        {
+            Tracked.Segment = Previous->Segment;
+        }
+    }
+    Players = Current;
+
+    Sources.Reset();
+
+    FStreamingSourceShape Shape;
+    Shape.bUseGridLoadingRange = Settings->StreamingSourceRadius <= 0.f;
+    Shape.Radius = Settings->StreamingSourceRadius;
+
+    // notes: no pawns yet (pre-possess / spectating) -> stream around the cameras like the PCs would
+    if (Players.Num() == 0)
+    {
+        FRaceViewpointArray Viewpoints;
+        URaceVehicleSubsystem::GatherViewpoints(World, Viewpoints);
+        for (int32 ViewIdx = 0; ViewIdx < Viewpoints.Num(); ++ViewIdx)
+        {
+            FWorldPartitionStreamingSource& Source = Sources.Emplace_GetRef(
+                FName(TEXT("RaceStream_View"), ViewIdx), Viewpoints[ViewIdx].Location, Viewpoints[ViewIdx].Forward.Rotation(),
+                EStreamingSourceTargetState::Activated, /*bBlockOnSlowLoading*/false,
+                EStreamingSourcePriority::Default, /*bRemote*/false);
+            Source.Shapes.Add(Shape);
+        }
+        return;
+    }
+
+    for (int32 PlayerIdx = 0; PlayerIdx < Players.Num(); ++PlayerIdx)
+    {
+        FTrackedPlayer& Tracked = Players[PlayerIdx];
+        const AMyCar* Car = Tracked.Car.Get();
+        const FVector CarLoc = Car->GetActorLocation();
+        const float Speed = Car->GetPhysicsSpeed();
+
+        // --- the car itself: highest priority, blocks if streaming falls behind ---
+        {
+            FWorldPartitionStreamingSource& Source = Sources.Emplace_GetRef(
+                FName(TEXT("RaceStream_Car"), PlayerIdx), CarLoc, Car->GetActorRotation(),
+                EStreamingSourceTargetState::Activated, /*bBlockOnSlowLoading*/true,
+                EStreamingSourcePriority::Highest, /*bRemote*/false, Speed);
+            Source.Shapes.Add(Shape);
+        }
+
+        // notes: no track line (no checkpoints) -> behaves like the default camera source
+        if (!GS || !GS->GetTrackLine().IsValid())
+        {
+            continue;
+        }
+        const FRaceTrackLine& Track = GS->GetTrackLine();
+
+        const float Progress = Track.ProjectNear(CarLoc, Tracked.Segment, RaceStreaming::SegmentSearchRadius, &Tracked.Segment);
+        const float Ahead = FMath::Max(Settings->StreamingMinLookahead, Speed * Settings->StreamingLookaheadSeconds);
+        const float Behind = Settings->StreamingBehindDistance;
+
+        // notes: spacing grows with speed so the source count stays bounded
+        const int32 MaxSamples = FMath::Max(1, Settings->MaxStreamingSourcesPerPlayer - 1);
+        const float Spacing = FMath::Max(Settings->StreamingSampleSpacing, (Ahead + Behind) / MaxSamples);
+
+        int32 SampleIdx = 0;
+        for (float Offset = -Behind; Offset <= Ahead && SampleIdx < MaxSamples; Offset += Spacing, ++SampleIdx)
+        {
+            FVector Loc, Dir;
+            Track.Sample(Progress + Offset, Loc, Dir);
+
+            const float Fraction = FMath::Clamp(Offset / FMath::Max(Ahead, 1.f), 0.f, 1.f);
+            const EStreamingSourcePriority Priority = Offset <= 0.f ? EStreamingSourcePriority::High
+                : (Fraction < 0.5f ? EStreamingSourcePriority::Normal : EStreamingSourcePriority::Low);
+
+            FWorldPartitionStreamingSource& Source = Sources.Emplace_GetRef(
+                FName(TEXT("RaceStream_Track"), PlayerIdx * 32 + SampleIdx), Loc, Dir.Rotation(),
+                EStreamingSourceTargetState::Activated, /*bBlockOnSlowLoading*/false,
+                Priority, /*bRemote*/false, Speed);
+            Source.Shapes.Add(Shape);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+// ============================================================================
+// RaceTrackBakeCommandlet.cpp
+// notes: editor-only work is behind WITH_EDITOR; in cooked builds the
+//        commandlet exists but refuses to run.
+// ============================================================================
+#include "RaceTrackBakeCommandlet.h"
+#include "Checkpoints.h"
+#include "RaceSettings.h"
+#include "RaceTrackData.h"
+
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EngineUtils.h"
+#include "GameMapsSettings.h"
+#include "UObject/SavePackage.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#endif
+
+URaceTrackBakeCommandlet::URaceTrackBakeCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 URaceTrackBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    TArray<FString> Maps;
+    FString MapParam;
+    if (FParse::Value(*Params, TEXT("Map="), MapParam, /*bShouldStopOnSeparator*/false))
+    {
+        MapParam.ParseIntoArray(Maps, TEXT(","));
+    }
+    else
+    {
+        Maps.Add(FSoftObjectPath(UGameMapsSettings::GetGameDefaultMap()).GetLongPackageName());
+    }
+
+    int32 Failures = 0;
+    for (const FString& Map : Maps)
+    {
+        if (!BakeMap(Map.TrimStartAndEnd()))
+        {
+            ++Failures;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("[TrackBake] %d map(s) baked, %d failed"), Maps.Num() - Failures, Failures);
+    return Failures == 0 ? 0 : 1;
+#else
+    UE_LOG(LogTemp, Error, TEXT("[TrackBake] Needs an editor build"));
+    return 1;
+#endif
+}
+
+bool URaceTrackBakeCommandlet::BakeMap(const FString& MapPackageName)
+{
+#if WITH_EDITOR
+    UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+    UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[TrackBake] Could not load map %s"), *MapPackageName);
+        return false;
+    }
+
+    // --- World needs its actors registered so WP actor descs can be loaded ---
+    World->WorldType = EWorldType::Editor;
+    World->AddToRoot();
+    if (!World->bIsWorldInitialized)
+    {
+        World->InitWorld(UWorld::InitializationValues().AllowAudioPlayback(false).CreatePhysicsScene(false)
+            .RequiresHitProxies(false).CreateNavigation(false).CreateAISystem(false).ShouldSimulatePhysics(false));
+    }
+    World->UpdateWorldComponents(/*bRerunConstructionScripts*/false, /*bCurrentLevelOnly*/false);
+
+    // --- Collect gates (persistent level + external WP actors) ---
+    // notes: gate data is copied out, so WP may release loaded actors at any point
+    TArray<FRaceTrackGate> Gates;
+    if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+    {
+        FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, ACheckpoints::StaticClass(),
+            [&Gates](const FWorldPartitionActorDescInstance* ActorDesc)
+            {
+                if (const ACheckpoints* CP = Cast<ACheckpoints>(ActorDesc->GetActor()))
+                {
+                    Gates.Add(URaceTrackData::MakeGate(*CP));
+                }
+                return true;
+            });
+    }
+    else
+    {
+        for (TActorIterator<ACheckpoints> It(World); It; ++It)
+        {
+            Gates.Add(URaceTrackData::MakeGate(**It));
+        }
+    }
+
+    // --- Bake into <TrackDataPath>/<MapName>_Track ---
+    const URaceSettings* Settings = URaceSettings::Get();
+    const FString AssetPath = URaceTrackData::GetAssetPathForMap(MapPackageName);
+    const FString PackageName = FPackageName::ObjectPathToPackageName(AssetPath);
+    const FString AssetName = FPackageName::ObjectPathToObjectName(AssetPath);
+
+    UPackage* AssetPackage = CreatePackage(*PackageName);
+    AssetPackage->FullyLoad();
+
+    URaceTrackData* Data = FindObject<URaceTrackData>(AssetPackage, *AssetName);
+    if (!Data)
+    {
+        Data = NewObject<URaceTrackData>(AssetPackage, *AssetName, RF_Public | RF_Standalone);
+        FAssetRegistryModule::AssetCreated(Data);
+    }
+
+    const bool bValid = Data->Bake(MoveTemp(Gates), Settings->RespawnSlotsPerGate, Settings->RespawnLaneSpacing, Settings->NumSectors);
+
+    // --- Track limits: distance field of the corridor between the gates ---
+    Data->TrackLimits.Reset();
+    if (Settings->bTrackLimits)
+    {
+        Data->TrackLimits.Bake(*Data, Settings->TrackLimitsCellSize);
+    }
+
+    // --- Save ---
+    Data->MarkPackageDirty();
+    const FString Filename = FPackageName::LongPackageNameToFilename(AssetPackage->GetName(), FPackageName::GetAssetPackageExtension());
+
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    const bool bSaved = UPackage::SavePackage(AssetPackage, Data, *Filename, SaveArgs);
+
+    UE_LOG(LogTemp, Display, TEXT("[TrackBake] %s -> %s: %d gates, %.0f cm, %d respawn slots, %d sectors, track limits %dx%d @ %.0f cm%s"),
+        *MapPackageName, *Filename, Data->Gates.Num(), Data->TrackLine.GetLength(),
+        Data->RespawnSlots.Num(), Data->Sectors.Num(), Data->TrackLimits.SizeX, Data->TrackLimits.SizeY,
+        Data->TrackLimits.CellSize, bValid ? TEXT("") : TEXT(" (WITH WARNINGS)"));
+
+    World->RemoveFromRoot();
+    if (World->bIsWorldInitialized)
+    {
+        World->CleanupWorld();
+    }
+    CollectGarbage(RF_NoFlags);
+
+    return bSaved && bValid;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,154 @@
+// ============================================================================
+// RaceTrackData.cpp
+// notes: Bake is shared by the commandlet and the runtime
+//        fallback, so an unbaked level behaves exactly like a baked one.
+// ============================================================================
+#include "RaceTrackData.h"
+#include "RaceMemory.h"
+#include "Checkpoints.h"
+#include "RaceSettings.h"
+
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+int32 URaceTrackData::FindGateIndex(int32 CheckPointNo) const
+{
+    return Gates.IndexOfByPredicate([CheckPointNo](const FRaceTrackGate& Gate) { return Gate.CheckPointNo == CheckPointNo; });
+}
+
+bool URaceTrackData::GetRespawnSlot(int32 GateIndex, int32 Slot, FTransform& OutTransform) const
+{
+    if (SlotsPerGate <= 0 || !Gates.IsValidIndex(GateIndex))
+    {
+        return false;
+    }
+
+    const int32 Index = GateIndex * SlotsPerGate + FMath::Abs(Slot) % SlotsPerGate;
+    if (!RespawnSlots.IsValidIndex(Index))
+    {
+        return false;
+    }
+    OutTransform = RespawnSlots[Index];
+    return true;
+}
+
+// ============================================================================
+// Bake
+// ============================================================================
+FRaceTrackGate URaceTrackData::MakeGate(const ACheckpoints& Checkpoint)
+{
+    FRaceTrackGate Gate;
+    Gate.CheckPointNo = Checkpoint.CheckPointNo;
+    Gate.bStartFinishLine = Checkpoint.bStartFinishLine;
+    Gate.Location = Checkpoint.GetActorLocation();
+    Gate.Rotation = Checkpoint.GetActorRotation();
+    Gate.HalfWidth = Checkpoint.Volume ? Checkpoint.Volume->GetScaledBoxExtent().Y : 0.f;
+    return Gate;
+}
+
+bool URaceTrackData::Bake(TArray<FRaceTrackGate> InGates, int32 InSlotsPerGate, float LaneSpacing, int32 NumSectors)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    Gates = MoveTemp(InGates);
+    RespawnSlots.Reset();
+    Sectors.Reset();
+    SlotsPerGate = FMath::Max(1, InSlotsPerGate);
+
+    if (Gates.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[TrackData] No checkpoints to bake"));
+        TrackLine.Build({});
+        return false;
+    }
+
+    // --- Validate numbering ---
+    bool bValid = true;
+    TSet<int32> Seen;
+    for (const FRaceTrackGate& Gate : Gates)
+    {
+        bool bDuplicate = false;
+        Seen.Add(Gate.CheckPointNo, &bDuplicate);
+        if (bDuplicate)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[TrackData] Duplicate CheckPointNo found: %d"), Gate.CheckPointNo);
+            bValid = false;
+        }
+    }
+
+    // --- Gates, ordered by CheckPointNo ---
+    Gates.StableSort([](const FRaceTrackGate& A, const FRaceTrackGate& B) { return A.CheckPointNo < B.CheckPointNo; });
+
+    // --- Centreline through the gates ---
+    TArray<FVector> LinePoints;
+    LinePoints.Reserve(Gates.Num());
+    for (const FRaceTrackGate& Gate : Gates)
+    {
+        LinePoints.Add(Gate.Location);
+    }
+    TrackLine.Build(LinePoints, /*bClosedLoop*/true);
+
+    for (int32 i = 0; i < Gates.Num(); ++i)
+    {
+        Gates[i].Distance = TrackLine.CumulativeLength.IsValidIndex(i) ? TrackLine.CumulativeLength[i] : 0.f;
+    }
+
+    // --- Respawn slots: lanes across each gate, lifted clear of the road ---
+    // notes: same slot -> lane mapping as AMyCar's placed-checkpoint fallback
+    //        (slots 0 / 1 straddle the centre), so baking a track moves nobody
+    RespawnSlots.Reserve(Gates.Num() * SlotsPerGate);
+    for (const FRaceTrackGate& Gate : Gates)
+    {
+        const FVector Right = Gate.Rotation.RotateVector(FVector::RightVector);
+        for (int32 Slot = 0; Slot < SlotsPerGate; ++Slot)
+        {
+            const float Lane = Slot - 0.5f;
+            const FVector Loc = Gate.Location + Right * (Lane * LaneSpacing) + FVector(0.f, 0.f, 100.f);
+            RespawnSlots.Emplace(Gate.Rotation, Loc);
+        }
+    }
+
+    // --- Sectors: equal lengths, snapped to the next gate ---
+    const float Length = TrackLine.GetLength();
+    NumSectors = FMath::Clamp(NumSectors, 1, Gates.Num());
+    for (int32 s = 0; s < NumSectors; ++s)
+    {
+        const float Target = Length * s / NumSectors;
+        int32 GateIdx = Gates.IndexOfByPredicate([Target](const FRaceTrackGate& Gate) { return Gate.Distance >= Target; });
+        GateIdx = (GateIdx == INDEX_NONE) ? Gates.Num() - 1 : GateIdx;
+
+        if (Sectors.Num() > 0 && Sectors.Last().FirstGate >= GateIdx)
+            continue; // gates too sparse for this many sectors
+
+        FRaceTrackSector& Sector = Sectors.AddDefaulted_GetRef();
+        Sector.FirstGate = GateIdx;
+        Sector.StartDistance = Gates[GateIdx].Distance;
+    }
+
+    if (!Gates.ContainsByPredicate([](const FRaceTrackGate& Gate) { return Gate.bStartFinishLine; }))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[TrackData] No start/finish gate; laps will never count"));
+        bValid = false;
+    }
+
+    return bValid;
+}
+
+// ============================================================================
+// Asset lookup
+// ============================================================================
+FString URaceTrackData::GetAssetPathForMap(const FString& MapPackageName)
+{
+    const FString AssetName = FPackageName::GetShortName(MapPackageName) + TEXT("_Track");
+    return URaceSettings::Get()->TrackDataPath / AssetName + TEXT(".") + AssetName;
+}
+
+FSoftObjectPath URaceTrackData::GetAssetPathForWorld(const UWorld* World)
+{
+    if (!World)
+    {
+        return FSoftObjectPath();
+    }
+    const FString MapPackageName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+    return FSoftObjectPath(GetAssetPathForMap(MapPackageName));
+}
@@ -0,0 +1,189 @@
+// ============================================================================
+// RaceTrackLimits.cpp
+// notes: the gate centres are joined by Hermite curves (tangents along the
+//        neighbouring gates, Catmull-Rom style) and sampled densely; the
+//        corridor is a chain of tapered capsules over those samples (radius
+//        lerped between the gate widths). Straight chords between sparse gates
+//        cut the inside of every bend. A cell's value is the smallest capsule
+//        distance. Brute force over samples, rows in parallel; bake time only.
+// ============================================================================
+#include "RaceTrackLimits.h"
+#include "RaceMemory.h"
+#include "RaceTrackData.h"
+
+#include "Async/ParallelFor.h"
+
+namespace RaceTrackLimits
+{
+    // notes: 4 MB of int16; larger tracks get coarser cells
+    constexpr int64 MaxCells = 2 * 1024 * 1024;
+
+    // notes: how far past the widest gate the field reaches (cm); further out is extrapolated
+    constexpr float Padding = 2000.f;
+
+    // notes: gates further apart than this many track widths only get a warning; the curve
+    //        between them is a guess, so a bend there needs more gates
+    constexpr float MaxGateGapInWidths = 8.f;
+
+    struct FSample
+    {
+        FVector2f Point;
+        float HalfWidth;
+    };
+
+    // notes: samples from gate s (inclusive) towards gate s + 1 (exclusive), at most one
+    //        narrower gate half width apart (never finer than a grid cell)
+    static void SampleSegment(const TArray<FVector2f>& Points, const TArray<FRaceTrackGate>& Gates, bool bClosedLoop,
+        int32 s, float CellSize, TArray<FSample>& Out)
+    {
+        const int32 Num = Points.Num();
+        const int32 Next = (s + 1) % Num;
+        const int32 Prev = bClosedLoop ? (s + Num - 1) % Num : FMath::Max(s - 1, 0);
+        const int32 NextNext = bClosedLoop ? (s + 2) % Num : FMath::Min(s + 2, Num - 1);
+
+        const FVector2f A = Points[s];
+        const FVector2f B = Points[Next];
+        const float Length = FVector2f::Distance(A, B);
+
+        // tangents scaled by this segment's length, so uneven gate spacing does not overshoot
+        const FVector2f TangentA = (B - Points[Prev]).GetSafeNormal() * Length;
+        const FVector2f TangentB = (Points[NextNext] - A).GetSafeNormal() * Length;
+
+        const float Spacing = FMath::Max(FMath::Min(Gates[s].HalfWidth, Gates[Next].HalfWidth), CellSize);
+        const int32 Steps = FMath::Max(FMath::CeilToInt(Length / Spacing), 1);
+        for (int32 i = 0; i < Steps; ++i)
+        {
+            const float Alpha = (float)i / Steps;
+            Out.Add({ FMath::CubicInterp(A, TangentA, B, TangentB, Alpha),
+                FMath::Lerp(Gates[s].HalfWidth, Gates[Next].HalfWidth, Alpha) });
+        }
+    }
+
+    static float CapsuleDistance(const FVector2f& P, const FVector2f& A, const FVector2f& B, float RadiusA, float RadiusB)
+    {
+        const FVector2f AB = B - A;
+        const float LenSq = AB.SizeSquared();
+        const float T = LenSq > UE_KINDA_SMALL_NUMBER ? FMath::Clamp(FVector2f::DotProduct(P - A, AB) / LenSq, 0.f, 1.f) : 0.f;
+        return FVector2f::Distance(P, A + AB * T) - FMath::Lerp(RadiusA, RadiusB, T);
+    }
+}
+
+float FRaceTrackLimits::Sample(const FVector& Location) const
+{
+    const float GX = ((float)Location.X - Origin.X) / CellSize;
+    const float GY = ((float)Location.Y - Origin.Y) / CellSize;
+    const float CX = FMath::Clamp(GX, 0.f, (float)(SizeX - 1));
+    const float CY = FMath::Clamp(GY, 0.f, (float)(SizeY - 1));
+
+    const int32 X0 = FMath::Min((int32)CX, SizeX - 2);
+    const int32 Y0 = FMath::Min((int32)CY, SizeY - 2);
+    const int16* Row0 = Distances.GetData() + Y0 * SizeX + X0;
+    const int16* Row1 = Row0 + SizeX;
+
+    const float Inside = FMath::BiLerp((float)Row0[0], (float)Row0[1], (float)Row1[0], (float)Row1[1], CX - X0, CY - Y0);
+    const float Outside = FVector2f(GX - CX, GY - CY).Size() * CellSize;
+    return Inside + Outside;
+}
+
+void FRaceTrackLimits::Reset()
+{
+    Origin = FVector2f::ZeroVector;
+    CellSize = 0.f;
+    SizeX = 0;
+    SizeY = 0;
+    Distances.Empty();
+}
+
+bool FRaceTrackLimits::Bake(const URaceTrackData& Track, float InCellSize)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    Reset();
+
+    const TArray<FRaceTrackGate>& Gates = Track.Gates;
+    const FRaceTrackLine& Line = Track.TrackLine;
+    if (Gates.Num() < 2 || Line.Points.Num() != Gates.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[TrackLimits] Needs a baked track with at least 2 gates"));
+        return false;
+    }
+    if (Gates.ContainsByPredicate([](const FRaceTrackGate& Gate) { return Gate.HalfWidth <= 0.f; }))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[TrackLimits] A gate has no width; track limits not baked"));
+        return false;
+    }
+
+    // --- 2D gate centres ---
+    const int32 NumPoints = Line.Points.Num();
+    const int32 NumSegments = Line.NumSegments();
+    TArray<FVector2f> Points;
+    Points.SetNumUninitialized(NumPoints);
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        Points[i] = FVector2f(Line.Points[i].X, Line.Points[i].Y);
+    }
+
+    for (int32 s = 0; s < NumSegments; ++s)
+    {
+        const int32 Next = (s + 1) % NumPoints;
+        const float Gap = FVector2f::Distance(Points[s], Points[Next]);
+        const float Width = 2.f * FMath::Min(Gates[s].HalfWidth, Gates[Next].HalfWidth);
+        if (Gap > Width * RaceTrackLimits::MaxGateGapInWidths)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[TrackLimits] Gates %d -> %d are %.0f m apart on a %.0f m wide track; add gates if it bends there"),
+                s, Next, Gap / 100.f, Width / 100.f);
+        }
+    }
+
+    // --- 2D corridor: dense samples along the curve through the gates ---
+    CellSize = FMath::Max(InCellSize, 10.f);
+    TArray<RaceTrackLimits::FSample> Samples;
+    for (int32 s = 0; s < NumSegments; ++s)
+    {
+        RaceTrackLimits::SampleSegment(Points, Gates, Line.bClosedLoop, s, CellSize, Samples);
+    }
+    if (!Line.bClosedLoop)
+    {
+        Samples.Add({ Points.Last(), Gates.Last().HalfWidth });
+    }
+    const int32 NumSamples = Samples.Num();
+    const int32 NumSampleSegments = Line.bClosedLoop ? NumSamples : NumSamples - 1;
+
+    FBox2f Bounds(ForceInit);
+    float MaxHalfWidth = 0.f;
+    for (const RaceTrackLimits::FSample& Sample : Samples)
+    {
+        Bounds += Sample.Point;
+        MaxHalfWidth = FMath::Max(MaxHalfWidth, Sample.HalfWidth);
+    }
+    Bounds = Bounds.ExpandBy(MaxHalfWidth + RaceTrackLimits::Padding);
+
+    // --- grid ---
+    const FVector2f Extent = Bounds.GetSize();
+    while ((int64)(FMath::CeilToInt(Extent.X / CellSize) + 1) * (FMath::CeilToInt(Extent.Y / CellSize) + 1) > RaceTrackLimits::MaxCells)
+    {
+        CellSize *= 1.25f;
+    }
+    SizeX = FMath::CeilToInt(Extent.X / CellSize) + 1;
+    SizeY = FMath::CeilToInt(Extent.Y / CellSize) + 1;
+    Origin = Bounds.Min;
+    Distances.SetNumUninitialized(SizeX * SizeY);
+
+    ParallelFor(SizeY, [&](int32 Y)
+    {
+        for (int32 X = 0; X < SizeX; ++X)
+        {
+            const FVector2f P = Origin + FVector2f(X, Y) * CellSize;
+            float Best = TNumericLimits<float>::Max();
+            for (int32 s = 0; s < NumSampleSegments; ++s)
+            {
+                const RaceTrackLimits::FSample& A = Samples[s];
+                const RaceTrackLimits::FSample& B = Samples[(s + 1) % NumSamples];
+                Best = FMath::Min(Best, RaceTrackLimits::CapsuleDistance(P, A.Point, B.Point, A.HalfWidth, B.HalfWidth));
+            }
+            Distances[Y * SizeX + X] = (int16)FMath::Clamp(FMath::RoundToInt(Best), (int32)MIN_int16, (int32)MAX_int16);
+        }
+    });
+
+    return true;
+}
@@ -0,0 +1,177 @@
+// ============================================================================
+// RaceTrackLine.cpp
+// notes: plain math, no world access -> safe from worker threads once built
+// ============================================================================
+#include "RaceTrackLine.h"
+#include "Algo/BinarySearch.h"
+
+void FRaceTrackLine::Build(const TArray<FVector>& InPoints, bool bInClosedLoop)
+{
+    Points = InPoints;
+    bClosedLoop = bInClosedLoop;
+    CumulativeLength.Reset();
+
+    if (Points.Num() < 2)
+    {
+        return;
+    }
+
+    const int32 NumSeg = NumSegments();
+    CumulativeLength.Reserve(NumSeg + 1);
+    CumulativeLength.Add(0.f);
+
+    for (int32 i = 0; i < NumSeg; ++i)
+    {
+        const FVector& A = Points[i];
+        const FVector& B = Points[(i + 1) % Points.Num()];
+        CumulativeLength.Add(CumulativeLength.Last() + FVector::Dist(A, B));
+    }
+}
+
+float FRaceTrackLine::WrapDistance(float Distance) const
+{
+    const float Length = GetLength();
+    if (Length <= 0.f)
+    {
+        return 0.f;
+    }
+    if (!bClosedLoop)
+    {
+        return FMath::Clamp(Distance, 0.f, Length);
+    }
+
+    Distance = FMath::Fmod(Distance, Length);
+    return Distance < 0.f ? Distance + Length : Distance;
+}
+
+int32 FRaceTrackLine::FindSegment(float Distance) const
+{
+    // notes: upper bound on cumulative lengths, then step back one
+    const int32 Upper = Algo::UpperBound(CumulativeLength, Distance);
+    return FMath::Clamp(Upper - 1, 0, NumSegments() - 1);
+}
+
+void FRaceTrackLine::Sample(float Distance, FVector& OutLocation, FVector& OutDirection) const
+{
+    if (!IsValid())
+    {
+        OutLocation = Points.Num() > 0 ? Points[0] : FVector::ZeroVector;
+        OutDirection = FVector::ForwardVector;
+        return;
+    }
+
+    Distance = WrapDistance(Distance);
+    const int32 Seg = FindSegment(Distance);
+
+    const FVector& A = Points[Seg];
+    const FVector& B = Points[(Seg + 1) % Points.Num()];
+    const float SegLen = CumulativeLength[Seg + 1] - CumulativeLength[Seg];
+    const float T = SegLen > KINDA_SMALL_NUMBER ? (Distance - CumulativeLength[Seg]) / SegLen : 0.f;
+
+    OutLocation = FMath::Lerp(A, B, T);
+    OutDirection = (B - A).GetSafeNormal(UE_KINDA_SMALL_NUMBER, FVector::ForwardVector);
+}
+
+int32 FRaceTrackLine::Locate(float Distance, float& OutAlpha) const
+{
+    OutAlpha = 0.f;
+    if (!IsValid())
+    {
+        return 0;
+    }
+
+    Distance = WrapDistance(Distance);
+    const int32 Seg = FindSegment(Distance);
+    const float SegLen = CumulativeLength[Seg + 1] - CumulativeLength[Seg];
+    OutAlpha = SegLen > KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - CumulativeLength[Seg]) / SegLen, 0.f, 1.f) : 0.f;
+    return Seg;
+}
+
+float FRaceTrackLine::ProjectOnSegment(int32 Segment, const FVector& Location, float& OutDistSq) const
+{
+    const FVector& A = Points[Segment];
+    const FVector& B = Points[(Segment + 1) % Points.Num()];
+    const FVector AB = B - A;
+    const float Len2 = FMath::Max(AB.SizeSquared(), 1.f);
+    const float T = FMath::Clamp(FVector::DotProduct(Location - A, AB) / Len2, 0.f, 1.f);
+
+    OutDistSq = FVector::DistSquared(Location, A + AB * T);
+    return CumulativeLength[Segment] + T * (CumulativeLength[Segment + 1] - CumulativeLength[Segment]);
+}
+
+float FRaceTrackLine::Project(const FVector& Location, int32* OutSegment) const
+{
+    if (!IsValid())
+    {
+        return 0.f;
+    }
+
+    float BestDistSq = TNumericLimits<float>::Max();
+    float BestAlong = 0.f;
+    int32 BestSeg = 0;
+
+    for (int32 Seg = 0; Seg < NumSegments(); ++Seg)
+    {
+        float DistSq = 0.f;
+        const float Along = ProjectOnSegment(Seg, Location, DistSq);
+        if (DistSq < BestDistSq)
+        {
+            BestDistSq = DistSq;
+            BestAlong = Along;
+            BestSeg = Seg;
+        }
+    }
+
+    if (OutSegment)
+    {
+        *OutSegment = BestSeg;
+    }
+    return BestAlong;
+}
+
+float FRaceTrackLine::ProjectNear(const FVector& Location, int32 HintSegment, int32 SearchRadius, int32* OutSegment) const
+{
+    if (!IsValid())
+    {
+        return 0.f;
+    }
+
+    const int32 NumSeg = NumSegments();
+    if (SearchRadius * 2 + 1 >= NumSeg)
+    {
+        return Project(Location, OutSegment);
+    }
+    const int32 Count = SearchRadius * 2 + 1;
+
+    float BestDistSq = TNumericLimits<float>::Max();
+    float BestAlong = 0.f;
+    int32 BestSeg = 0;
+
+    for (int32 k = 0; k < Count; ++k)
+    {
+        int32 Seg = HintSegment - SearchRadius + k;
+        if (bClosedLoop)
+        {
+            Seg = (Seg % NumSeg + NumSeg) % NumSeg;
+        }
+        else if (Seg < 0 || Seg >= NumSeg)
+        {
+            continue;
+        }
+
+        float DistSq = 0.f;
+        const float Along = ProjectOnSegment(Seg, Location, DistSq);
+        if (DistSq < BestDistSq)
+        {
+            BestDistSq = DistSq;
+            BestAlong = Along;
+            BestSeg = Seg;
+        }
+    }
+
+    if (OutSegment)
+    {
+        *OutSegment = BestSeg;
+    }
+    return BestAlong;
+}
@@ -0,0 +1,334 @@
+// ============================================================================
+// RaceTrainingSubsystem.cpp
+// notes: the engine runs with a fixed time step equal to the race logic step,
+//        so one frame == one URaceLogicSubsystem step == one training step.
+//        Physics substeps inside that frame as usual.
+// ============================================================================
+#include "RaceTrainingSubsystem.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceGameState.h"
+#include "RaceInstanceSubsystem.h"
+#include "RaceLineData.h"
+#include "RaceSettings.h"
+#include "RaceTrainingProtocol.h"
+#include "RaceVehicleSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+
+// ============================================================================
+// Lifetime
+// ============================================================================
+bool URaceTrainingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    FString Name;
+    return Super::ShouldCreateSubsystem(Outer)
+        && FParse::Value(FCommandLine::Get(), TEXT("RaceTraining="), Name)
+        && !Name.IsEmpty();
+}
+
+void URaceTrainingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    LLM_SCOPE_BYTAG(Race_State);
+
+    Super::Initialize(Collection);
+
+    FParse::Value(FCommandLine::Get(), TEXT("RaceTraining="), RegionName);
+
+    int32 RequestedCars = URaceSettings::Get()->TrainingMaxCars;
+    FParse::Value(FCommandLine::Get(), TEXT("RaceTrainingCars="), RequestedCars);
+    MaxCars = (uint32)FMath::Clamp(RequestedCars, 1, 1024);
+
+    Region = FPlatformMemory::MapNamedSharedMemoryRegion(*RegionName, /*bCreate*/true,
+        FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write,
+        RaceTraining::GetRegionSize(MaxCars));
+    if (!Region)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Training] Could not map shared memory region '%s'"), *RegionName);
+        return;
+    }
+
+    FMemory::Memzero(Region->GetAddress(), Region->GetSize());
+    Header = static_cast<FRaceTrainingHeader*>(Region->GetAddress());
+    Header->Magic = RaceTraining::Magic;
+    Header->Version = RaceTraining::Version;
+    Header->MaxCars = MaxCars;
+
+    // notes: one frame per logic step, no real-time pacing
+    const float StepSeconds = 1.f / URaceSettings::Get()->RaceLogicHz;
+    Header->StepSeconds = StepSeconds;
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(StepSeconds);
+
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &URaceTrainingSubsystem::HandlePostLoadMap);
+    BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &URaceTrainingSubsystem::HandleBeginFrame);
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &URaceTrainingSubsystem::HandleEndFrame);
+
+    UE_LOG(LogTemp, Log, TEXT("[Training] Region '%s' mapped: %u car slots, %.4fs per step"),
+        *RegionName, MaxCars, StepSeconds);
+}
+
+void URaceTrainingSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+    if (Region)
+    {
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+        Region = nullptr;
+        Header = nullptr;
+    }
+
+    Super::Deinitialize();
+}
+
+void URaceTrainingSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    if (!LoadedWorld || URaceInstanceSubsystem::IsInstanceWorld(LoadedWorld))
+    {
+        return;
+    }
+    bMapReady = true;
+
+    // --- single world: top the host world up to MaxCars AI cars ---
+    if (!GetGameInstance()->GetSubsystem<URaceInstanceSubsystem>())
+    {
+        const URaceVehicleSubsystem* Vehicles = LoadedWorld->GetSubsystem<URaceVehicleSubsystem>();
+        const int32 Existing = Vehicles ? Vehicles->GetCars().Num() : 0;
+        if (Existing < (int32)MaxCars)
+        {
+            TArray<AMyCar*> Spawned;
+            URaceInstanceSubsystem::SpawnGridCars(LoadedWorld, MaxCars - Existing, Spawned);
+        }
+    }
+}
+
+void URaceTrainingSubsystem::GetTrainingWorlds(TArray<UWorld*, TInlineAllocator<8>>& OutWorlds) const
+{
+    if (const URaceInstanceSubsystem* Instances = GetGameInstance()->GetSubsystem<URaceInstanceSubsystem>())
+    {
+        for (int32 i = 0; i < Instances->NumInstances(); ++i)
+        {
+            OutWorlds.Add(Instances->GetInstanceWorld(i));
+        }
+        return;
+    }
+    OutWorlds.Add(GetGameInstance()->GetWorld());
+}
+
+// ============================================================================
+// Step
+// ============================================================================
+void URaceTrainingSubsystem::HandleBeginFrame()
+{
+    if (!Header || !bMapReady || !WaitForActions())
+    {
+        return;
+    }
+
+    GatherCars();
+
+    switch ((ERaceTrainingCommand)Header->Command)
+    {
+    case ERaceTrainingCommand::Quit:
+        FPlatformAtomics::AtomicStore(&Header->ObservationSeq, LastActionSeq);
+        FPlatformMisc::RequestExit(/*bForce*/false, TEXT("RaceTraining"));
+        return;
+
+    case ERaceTrainingCommand::Reset:
+        ResetEpisode();
+        break;
+
+    default:
+        ApplyActions();
+        break;
+    }
+    bStepPending = true;
+}
+
+void URaceTrainingSubsystem::HandleEndFrame()
+{
+    if (!bStepPending)
+    {
+        return;
+    }
+    bStepPending = false;
+
+    WriteObservations();
+    Header->NumCars = Cars.Num();
+    ++Header->StepIndex;
+
+    // notes: observations must be visible before the trainer sees the sequence move
+    FPlatformMisc::MemoryBarrier();
+    FPlatformAtomics::AtomicStore(&Header->ObservationSeq, LastActionSeq);
+}
+
+bool URaceTrainingSubsystem::WaitForActions()
+{
+    const double Deadline = FPlatformTime::Seconds() + URaceSettings::Get()->TrainingWaitTimeoutSeconds;
+
+    int64 Seq = FPlatformAtomics::AtomicRead(&Header->ActionSeq);
+    while (Seq == LastActionSeq)
+    {
+        if (IsEngineExitRequested())
+        {
+            return false;
+        }
+        if (FPlatformTime::Seconds() > Deadline)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[Training] No actions on '%s' for %.0fs, exiting"),
+                *RegionName, URaceSettings::Get()->TrainingWaitTimeoutSeconds);
+            FPlatformMisc::RequestExit(/*bForce*/false, TEXT("RaceTraining"));
+            return false;
+        }
+        FPlatformProcess::YieldThread();
+        Seq = FPlatformAtomics::AtomicRead(&Header->ActionSeq);
+    }
+
+    LastActionSeq = Seq;
+    return true;
+}
+
+void URaceTrainingSubsystem::GatherCars()
+{
+    TArray<UWorld*, TInlineAllocator<8>> Worlds;
+    GetTrainingWorlds(Worlds);
+
+    TArray<AMyCar*, TInlineAllocator<64>> Current;
+    for (UWorld* World : Worlds)
+    {
+        const URaceVehicleSubsystem* Vehicles = World ? World->GetSubsystem<URaceVehicleSubsystem>() : nullptr;
+        if (!Vehicles)
+        {
+            continue;
+        }
+        for (AMyCar* Car : Vehicles->GetCars())
+        {
+            if (IsValid(Car) && Current.Num() < (int32)MaxCars)
+            {
+                Current.Add(Car);
+            }
+        }
+    }
+
+    // notes: slot -> car mapping changed, so the progress hints are stale
+    bool bSame = Current.Num() == Cars.Num();
+    for (int32 i = 0; bSame && i < Current.Num(); ++i)
+    {
+        bSame = Current[i] == Cars[i];
+    }
+    if (!bSame)
+    {
+        Cars.Reset(Current.Num());
+        Cars.Append(Current);
+
+        // notes: the trainer's actions are the only input; the line driver would overwrite them and respawn cars
+        for (AMyCar* Car : Cars)
+        {
+            Car->bLineDriver = false;
+        }
+        ProgressSegments.Init(INDEX_NONE, Cars.Num());
+        GuideSegments.Init(INDEX_NONE, Cars.Num());
+    }
+}
+
+void URaceTrainingSubsystem::ApplyActions()
+{
+    const FRaceTrainingAction* Actions = RaceTraining::GetActions(Header);
+    for (int32 i = 0; i < Cars.Num(); ++i)
+    {
+        const FRaceTrainingAction& Action = Actions[i];
+
+        FRaceDriveInput Input;
+        Input.Throttle = FMath::Clamp(Action.Throttle, -1.f, 1.f);
+        Input.Steering = FMath::Clamp(Action.Steering, -1.f, 1.f);
+        Input.Brake = FMath::Clamp(Action.Brake, 0.f, 1.f);
+        Input.bHandbrake = Action.bHandbrake != 0;
+        Cars[i]->SetDriveInput(Input);
+    }
+}
+
+void URaceTrainingSubsystem::ResetEpisode()
+{
+    TArray<UWorld*, TInlineAllocator<8>> Worlds;
+    GetTrainingWorlds(Worlds);
+    for (UWorld* World : Worlds)
+    {
+        if (ARaceGameState* GS = World ? World->GetGameState<ARaceGameState>() : nullptr)
+        {
+            GS->CurrentLap = 1;
+            GS->bTimerRunning = true;
+            GS->ResetTimer();
+        }
+    }
+
+    for (AMyCar* Car : Cars)
+    {
+        Car->ResetRaceProgress();
+    }
+    ProgressSegments.Init(INDEX_NONE, Cars.Num());
+    GuideSegments.Init(INDEX_NONE, Cars.Num());
+}
+
+void URaceTrainingSubsystem::WriteObservations()
+{
+    FRaceTrainingObservation* Observations = RaceTraining::GetObservations(Header, MaxCars);
+    for (int32 i = 0; i < Cars.Num(); ++i)
+    {
+        const AMyCar* Car = Cars[i];
+        FRaceTrainingObservation& Obs = Observations[i];
+        const FVector Location = Car->GetActorLocation();
+
+        float LapFraction = 0.f;
+        const ARaceGameState* GS = Car->GetWorld()->GetGameState<ARaceGameState>();
+        const FRaceTrackLine* Line = GS ? &GS->GetTrackLine() : nullptr;
+        if (Line && Line->IsValid() && Line->GetLength() > 0.f)
+        {
+            int32& Segment = ProgressSegments[i];
+            const float Distance = Segment == INDEX_NONE
+                ? Line->Project(Location, &Segment)
+                : Line->ProjectNear(Location, Segment, /*SearchRadius*/2, &Segment);
+            LapFraction = Distance / Line->GetLength();
+        }
+
+        float LineOffset = 0.f;
+        float TargetSpeed = 0.f;
+        const FRaceTrackLine* Guide = GS ? &GS->GetGuideLine() : nullptr;
+        if (Guide && Guide->IsValid())
+        {
+            int32& Segment = GuideSegments[i];
+            const float Distance = Segment == INDEX_NONE
+                ? Guide->Project(Location, &Segment)
+                : Guide->ProjectNear(Location, Segment, /*SearchRadius*/2, &Segment);
+
+            FVector GuideLocation, GuideDirection;
+            Guide->Sample(Distance, GuideLocation, GuideDirection);
+            LineOffset = FVector::DotProduct(Location - GuideLocation, FVector::CrossProduct(FVector::UpVector, GuideDirection).GetSafeNormal());
+            if (const URaceLineData* RacingLine = GS->GetRacingLine())
+            {
+                TargetSpeed = RacingLine->GetTargetSpeed(Distance);
+            }
+        }
+
+        Obs.Speed = Car->GetPhysicsSpeed();
+        Obs.Progress = (Car->Lap - 1) + LapFraction;
+        Obs.DistanceToNextCheckpoint = Car->DistanceToNextCheckpoint;
+        Obs.Lap = Car->Lap;
+        Obs.CheckpointIndex = Car->CurrentCheckpointIndex;
+        Obs.bCrashed = Car->IsCrashed() ? 1u : 0u;
+        Obs.Location[0] = Location.X;
+        Obs.Location[1] = Location.Y;
+        Obs.Location[2] = Location.Z;
+        Obs.Yaw = Car->GetActorRotation().Yaw;
+        Obs.LineOffset = LineOffset;
+        Obs.TargetSpeed = TargetSpeed;
+    }
+}
@@ -0,0 +1,228 @@
+// ============================================================================
+// RaceVehicleSubsystem.cpp
+// notes: tiers are re-evaluated at LODUpdateInterval, not per frame; the car
+//        applies the tier itself (AMyCar::SetSimLOD) so promotion/demotion
+//        logic stays next to the physics state it touches.
+// ============================================================================
+#include "RaceVehicleSubsystem.h"
+#include "RaceMemory.h"
+#include "MyCar.h"
+#include "RaceSettings.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+bool URaceVehicleSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URaceVehicleSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URaceVehicleSubsystem, STATGROUP_Tickables);
+}
+
+void URaceVehicleSubsystem::RegisterCar(AMyCar* Car)
+{
+    LLM_SCOPE_BYTAG(Race_Vehicles);
+
+    if (Car)
+    {
+        Cars.AddUnique(Car);
+    }
+}
+
+void URaceVehicleSubsystem::UnregisterCar(AMyCar* Car)
+{
+    Cars.RemoveSwap(Car);
+}
+
+// ============================================================================
+// Viewpoints
+// ============================================================================
+void URaceVehicleSubsystem::GatherViewpoints(const UWorld* World, FRaceViewpointArray& OutViewpoints)
+{
+    OutViewpoints.Reset();
+    if (!World)
+    {
+        return;
+    }
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PC = It->Get();
+        if (!PC || !PC->IsLocalController() || !PC->GetLocalPlayer())
+        {
+            continue;
+        }
+
+        FVector Loc;
+        FRotator Rot;
+        PC->GetPlayerViewPoint(Loc, Rot);
+
+        FRaceViewpoint& View = OutViewpoints.AddDefaulted_GetRef();
+        View.Location = Loc;
+        View.Forward = Rot.Vector();
+        View.FOVDegrees = PC->PlayerCameraManager ? PC->PlayerCameraManager->GetFOVAngle() : 90.f;
+    }
+
+    // --- Dedicated server: nobody renders, so relevance follows the players' cars ---
+    if (OutViewpoints.Num() == 0)
+    {
+        for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+        {
+            const APlayerController* PC = It->Get();
+            if (const APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+            {
+                FRaceViewpoint& View = OutViewpoints.AddDefaulted_GetRef();
+                View.Location = Pawn->GetActorLocation();
+                View.Forward = Pawn->GetActorForwardVector();
+            }
+        }
+    }
+}
+
+float URaceVehicleSubsystem::MinDistanceToViewpoints(const FRaceViewpointArray& Viewpoints, const FVector& Location)
+{
+    float MinDistSq = TNumericLimits<float>::Max();
+    for (const FRaceViewpoint& View : Viewpoints)
+    {
+        MinDistSq = FMath::Min(MinDistSq, (float)FVector::DistSquared(View.Location, Location));
+    }
+    return Viewpoints.Num() > 0 ? FMath::Sqrt(MinDistSq) : 0.f;
+}
+
+// ============================================================================
+// Sim LOD
+// ============================================================================
+void URaceVehicleSubsystem::Tick(float DeltaTime)
+{
+    UpdateSlipstream();
+
+    TimeSinceLODUpdate += DeltaTime;
+    if (TimeSinceLODUpdate >= URaceSettings::Get()->LODUpdateInterval)
+    {
+        TimeSinceLODUpdate = 0.f;
+        UpdateSimLOD();
+    }
+}
+
+ERaceSimLOD URaceVehicleSubsystem::PickTier(const AMyCar* Car, float Distance) const
+{
+    const URaceSettings* Settings = URaceSettings::Get();
+    const ERaceSimLOD Current = Car->GetSimLOD();
+    const float H = Settings->LODHysteresis;
+
+    // notes: the current tier gets the wider side of each dead band
+    const float FullEdge = Settings->FullSimDistance * (Current == ERaceSimLOD::Full ? 1.f + H : 1.f - H);
+    const float ProxyEdge = Settings->ProxySimDistance * (Current == ERaceSimLOD::Proxy ? 1.f - H : 1.f + H);
+
+    if (Distance <= FullEdge)
+    {
+        return ERaceSimLOD::Full;
+    }
+    if (Distance >= ProxyEdge && Car->CanUseProxySim())
+    {
+        return ERaceSimLOD::Proxy;
+    }
+    return ERaceSimLOD::Reduced;
+}
+
+void URaceVehicleSubsystem::UpdateSimLOD()
+{
+    FRaceViewpointArray Viewpoints;
+    GatherViewpoints(GetWorld(), Viewpoints);
+    if (Viewpoints.Num() == 0)
+    {
+        return;
+    }
+
+    for (AMyCar* Car : Cars)
+    {
+        if (!IsValid(Car))
+        {
+            continue;
+        }
+
+        const float Distance = MinDistanceToViewpoints(Viewpoints, Car->GetActorLocation());
+        const ERaceSimLOD Tier = PickTier(Car, Distance);
+        if (Tier != Car->GetSimLOD())
+        {
+            Car->SetSimLOD(Tier);
+        }
+    }
+}
+
+// ============================================================================
+// Slipstream
+// ============================================================================
+void URaceVehicleSubsystem::UpdateSlipstream()
+{
+    LLM_SCOPE_BYTAG(Race_Vehicles);
+
+    const URaceSettings* Settings = URaceSettings::Get();
+    const UWorld* World = GetWorld();
+    if (!Settings->bEnableSlipstream || World->GetNetMode() == NM_Client)
+    {
+        return;
+    }
+
+    // --- one grid for all cars this frame ---
+    // notes: dead entries keep their slot (indices match Cars) and are skipped in the query
+    CarPositions.Reset();
+    for (const AMyCar* Car : Cars)
+    {
+        CarPositions.Add(IsValid(Car) ? Car->GetActorLocation() : FVector::ZeroVector);
+    }
+    ProximityGrid.Build(CarPositions, Settings->SlipstreamRange);
+
+    const float Range = Settings->SlipstreamRange;
+    const float CosCone = FMath::Cos(FMath::DegreesToRadians(Settings->SlipstreamConeHalfAngle));
+    const float CosHeading = 0.8f; // leader must be roughly going our way (~37 deg)
+
+    for (int32 i = 0; i < Cars.Num(); ++i)
+    {
+        AMyCar* Follower = Cars[i];
+        if (!IsValid(Follower))
+        {
+            continue;
+        }
+
+        // notes: proxies don't simulate, so forces would be lost anyway
+        if (Follower->GetSimLOD() == ERaceSimLOD::Proxy || Follower->GetPhysicsSpeed() < Settings->SlipstreamMinSpeed)
+        {
+            Follower->SetSlipstream(0.f);
+            continue;
+        }
+
+        const FVector FollowerLoc = CarPositions[i];
+        const FVector FollowerFwd = Follower->GetActorForwardVector();
+        float Best = 0.f;
+
+        ProximityGrid.ForEachNearby(FollowerLoc, [&](int32 j)
+        {
+            if (j == i || !IsValid(Cars[j]))
+            {
+                return;
+            }
+
+            const FVector ToLeader = CarPositions[j] - FollowerLoc;
+            const float Dist = ToLeader.Size();
+            if (Dist <= KINDA_SMALL_NUMBER || Dist > Range)
+            {
+                return;
+            }
+            if (FVector::DotProduct(ToLeader / Dist, FollowerFwd) < CosCone
+                || FVector::DotProduct(Cars[j]->GetActorForwardVector(), FollowerFwd) < CosHeading)
+            {
+                return;
+            }
+
+            // closer = stronger tow
+            Best = FMath::Max(Best, 1.f - Dist / Range);
+        });
+
+        Follower->SetSlipstream(Best);
+    }
+}
@@ -0,0 +1,189 @@
+// ============================================================================
+// SRaceMinimap.cpp
+// notes: markers are quads in one FSlateDrawElement::MakeCustomVerts call, so
+//        the marker count never adds draw elements or batches.
+// ============================================================================
+#include "SRaceMinimap.h"
+#include "RaceMemory.h"
+#include "Collectable.h"
+#include "MyCar.h"
+#include "RaceGameState.h"
+#include "RaceSignificanceSubsystem.h"
+#include "RaceTrackData.h"
+#include "RaceVehicleSubsystem.h"
+
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/PlayerController.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Styling/CoreStyle.h"
+
+namespace RaceMinimap
+{
+    constexpr float Padding = 8.f;
+
+    const FColor OwnCarColor(255, 210, 0);
+    const FColor PlayerCarColor(235, 235, 235);
+    const FColor AICarColor(150, 150, 150);
+    const FColor CollectableColor(0, 200, 255);
+    const FLinearColor OutlineColor(1.f, 1.f, 1.f, 0.6f);
+    const FLinearColor BackgroundColor(0.f, 0.f, 0.f, 0.35f);
+}
+
+void SRaceMinimap::Construct(const FArguments& InArgs)
+{
+    OwningPlayer = InArgs._OwningPlayer;
+    Size = InArgs._Size;
+    MarkerSize = InArgs._MarkerSize;
+
+    if (FSlateApplication::IsInitialized())
+    {
+        WhiteHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(*FCoreStyle::Get().GetBrush("WhiteBrush"));
+    }
+}
+
+FVector2D SRaceMinimap::ComputeDesiredSize(float) const
+{
+    return FVector2D(Size, Size);
+}
+
+bool SRaceMinimap::CacheOutline(const UWorld& World) const
+{
+    if (NormalizedOutline.Num() > 0)
+    {
+        return true;
+    }
+
+    const ARaceGameState* GS = World.GetGameState<ARaceGameState>();
+    const FRaceTrackLine* Line = GS ? &GS->GetTrackLine() : nullptr;
+    if (!Line || !Line->IsValid())
+    {
+        return false;
+    }
+
+    LLM_SCOPE_BYTAG(Race_HUD);
+
+    FBox2f Bounds(ForceInit);
+    for (const FVector& Point : Line->Points)
+    {
+        Bounds += FVector2f(Point.X, Point.Y);
+    }
+
+    // --- fit the longer axis into [0, 1]; margin so markers at the edge stay inside ---
+    const FVector2f Extent = Bounds.GetSize();
+    const float Margin = FMath::Max(Extent.X, Extent.Y) * 0.05f;
+    WorldMin = Bounds.Min - FVector2f(Margin);
+    WorldToUnit = 1.f / FMath::Max(FMath::Max(Extent.X, Extent.Y) + 2.f * Margin, 1.f);
+    UnitExtent = (Extent + FVector2f(2.f * Margin)) * WorldToUnit;
+
+    NormalizedOutline.Reset(Line->Points.Num() + 1);
+    for (const FVector& Point : Line->Points)
+    {
+        // world +X up, +Y right
+        NormalizedOutline.Add(FVector2f((Point.Y - WorldMin.Y) * WorldToUnit, UnitExtent.X - (Point.X - WorldMin.X) * WorldToUnit));
+    }
+    if (Line->bClosedLoop)
+    {
+        NormalizedOutline.Add(NormalizedOutline[0]);
+    }
+
+    LaidOutSize = FVector2f::ZeroVector;
+    return true;
+}
+
+FVector2f SRaceMinimap::WorldToMap(const FVector& Location, const FVector2f& MapSize) const
+{
+    const FVector2f Unit((Location.Y - WorldMin.Y) * WorldToUnit, UnitExtent.X - (Location.X - WorldMin.X) * WorldToUnit);
+    return FVector2f(RaceMinimap::Padding) + Unit * MapSize;
+}
+
+void SRaceMinimap::AddMarker(const FSlateRenderTransform& Transform, const FVector2f& Center, float HalfSize, const FColor& Color) const
+{
+    const SlateIndex Base = (SlateIndex)MarkerVerts.Num();
+    MarkerVerts.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(Transform, Center + FVector2f(-HalfSize, -HalfSize), FVector2f(0.f, 0.f), Color));
+    MarkerVerts.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(Transform, Center + FVector2f(HalfSize, -HalfSize), FVector2f(1.f, 0.f), Color));
+    MarkerVerts.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(Transform, Center + FVector2f(HalfSize, HalfSize), FVector2f(1.f, 1.f), Color));
+    MarkerVerts.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(Transform, Center + FVector2f(-HalfSize, HalfSize), FVector2f(0.f, 1.f), Color));
+
+    MarkerIndices.Add(Base);
+    MarkerIndices.Add(Base + 1);
+    MarkerIndices.Add(Base + 2);
+    MarkerIndices.Add(Base);
+    MarkerIndices.Add(Base + 2);
+    MarkerIndices.Add(Base + 3);
+}
+
+int32 SRaceMinimap::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    const APlayerController* PC = OwningPlayer.Get();
+    const UWorld* World = PC ? PC->GetWorld() : nullptr;
+    if (!World || !CacheOutline(*World))
+    {
+        return LayerId;
+    }
+
+    LLM_SCOPE_BYTAG(Race_HUD);
+
+    // --- background ---
+    FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(),
+        FCoreStyle::Get().GetBrush("WhiteBrush"), ESlateDrawEffect::None, RaceMinimap::BackgroundColor);
+
+    // --- outline: re-laid out only when the widget size changed ---
+    const FVector2f LocalSize(AllottedGeometry.GetLocalSize());
+    const FVector2f MapSize(FMath::Min(LocalSize.X, LocalSize.Y) - 2.f * RaceMinimap::Padding);
+    if (!LaidOutSize.Equals(LocalSize))
+    {
+        LaidOutSize = LocalSize;
+        OutlinePoints.Reset(NormalizedOutline.Num());
+        for (const FVector2f& Point : NormalizedOutline)
+        {
+            OutlinePoints.Add(FVector2f(RaceMinimap::Padding) + Point * MapSize);
+        }
+    }
+    FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(), OutlinePoints,
+        ESlateDrawEffect::None, RaceMinimap::OutlineColor, /*bAntialias*/true, /*Thickness*/2.f);
+
+    // --- markers: collectables first, own car last so it is drawn on top ---
+    MarkerVerts.Reset();
+    MarkerIndices.Reset();
+    const FSlateRenderTransform& Transform = AllottedGeometry.GetAccumulatedRenderTransform();
+    const float Half = MarkerSize * 0.5f;
+
+    if (const URaceSignificanceSubsystem* Significance = World->GetSubsystem<URaceSignificanceSubsystem>())
+    {
+        for (const ACollectable* Collectable : Significance->GetCollectables())
+        {
+            if (IsValid(Collectable) && !Collectable->IsHidden())
+            {
+                AddMarker(Transform, WorldToMap(Collectable->GetActorLocation(), MapSize), Half * 0.6f, RaceMinimap::CollectableColor);
+            }
+        }
+    }
+
+    const AMyCar* OwnCar = Cast<AMyCar>(PC->GetPawn());
+    if (const URaceVehicleSubsystem* Vehicles = World->GetSubsystem<URaceVehicleSubsystem>())
+    {
+        for (const AMyCar* Car : Vehicles->GetCars())
+        {
+            if (IsValid(Car) && Car != OwnCar)
+            {
+                AddMarker(Transform, WorldToMap(Car->GetActorLocation(), MapSize), Half,
+                    Car->bIsAI ? RaceMinimap::AICarColor : RaceMinimap::PlayerCarColor);
+            }
+        }
+    }
+    if (OwnCar)
+    {
+        AddMarker(Transform, WorldToMap(OwnCar->GetActorLocation(), MapSize), Half * 1.3f, RaceMinimap::OwnCarColor);
+    }
+
+    if (MarkerIndices.Num() > 0 && WhiteHandle.IsValid())
+    {
+        FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId + 2, WhiteHandle, MarkerVerts, MarkerIndices,
+            /*InInstanceData*/nullptr, /*InInstanceOffset*/0, /*InNumInstances*/0);
+    }
+
+    return LayerId + 2;
+}
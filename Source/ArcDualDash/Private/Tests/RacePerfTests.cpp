@@ -0,0 +1,605 @@
+// ============================================================================
+// RacePerfTests.cpp
+// purpose: micro-benchmarks for the race logic on synthetic, headless worlds
+//          (8 / 64 / 256 cars + N checkpoints / collectables).
+//            ArcDualDash.Perf.Leaderboard      ARaceGameState::UpdateLeaderboard
+//            ArcDualDash.Perf.LapCheckpoint    AMyCar::LapCheckpoint, every car
+//            ArcDualDash.Perf.CollectablePickup overlap -> score / boost / consume
+//            ArcDualDash.Perf.CrashRespawn     HandleCarCrash + RespawnCar, every car
+//            ArcDualDash.Perf.GhostToggle      BeginGhost + EndGhost, every car
+//            ArcDualDash.Perf.QuietLap         no UObject created during a scripted lap
+//            ArcDualDash.Perf.SteadyStateMallocs no heap allocation in the race logic tick
+// output: Saved/Automation/RacePerf.csv (one row per case, appended).
+//         A case fails above its budget, or when it regresses more than
+//         -RacePerfTolerance (default 0.25) over Saved/Automation/RacePerfBaseline.csv.
+// run:    UnrealEditor-Cmd ArcDualDash.uproject -ExecCmds="Automation RunTests ArcDualDash.Perf; Quit"
+//             -unattended -nullrhi -RaceMallocCounter
+// ============================================================================
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Checkpoints.h"
+#include "Collectable.h"
+#include "MyCar.h"
+#include "RaceGameState.h"
+#include "RaceLogicSubsystem.h"
+#include "RaceMallocCounter.h"
+#include "RaceSettings.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+// notes: friend of AMyCar / ACollectable so the benchmarks call the real code paths
+struct FRacePerfTestAccess
+{
+    static void Crash(AMyCar* Car) { Car->HandleCarCrash(); }
+    static void Respawn(AMyCar* Car) { Car->RespawnCar(); }
+    static void BeginGhost(AMyCar* Car) { Car->BeginGhost(); }
+    static void EndGhost(AMyCar* Car) { Car->EndGhost(); }
+
+    static void Pickup(ACollectable* Collectable, AMyCar* Car)
+    {
+        Collectable->OnSphereBeginOverlap(nullptr, Car, nullptr, 0, false, FHitResult());
+    }
+
+    static void ResetPickup(ACollectable* Collectable)
+    {
+        Collectable->bConsumed = false;
+        Collectable->SetLifeSpan(0.f);
+        Collectable->SetActorHiddenInGame(false);
+        Collectable->SetActorEnableCollision(true);
+    }
+};
+
+namespace RacePerf
+{
+    constexpr int32 NumCheckpoints = 16;
+    constexpr float TrackRadius = 50000.f;
+    constexpr TCHAR CsvHeader[] = TEXT("Timestamp,Test,Cars,Checkpoints,Collectables,Iterations,MedianUs,MaxUs,BudgetUs,BaselineUs,Result");
+
+    // ------------------------------------------------------------------------
+    // Synthetic race: ring of checkpoints, cars on a grid at the start line,
+    // collectables spread around the ring. No game mode, no rendering.
+    // ------------------------------------------------------------------------
+    struct FFixture
+    {
+        UWorld* World = nullptr;
+        ARaceGameState* GameState = nullptr;
+        TArray<AMyCar*> Cars;
+        TArray<ACheckpoints*> Checkpoints;
+        TArray<ACollectable*> Collectables;
+
+        // notes: scripted laps finish races; keep them out of Saved/RaceResults
+        TGuardValue<bool> RecordResultsGuard{ GetMutableDefault<URaceSettings>()->bRecordResults, false };
+
+        ~FFixture() { Destroy(); }
+
+        bool Create(int32 NumCars, int32 NumCollectables)
+        {
+            World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld*/false, TEXT("RacePerfWorld"));
+            FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+            Context.SetCurrentWorld(World);
+            World->InitializeActorsForPlay(FURL());
+
+            GameState = World->SpawnActor<ARaceGameState>();
+            World->SetGameState(GameState);
+
+            for (int32 i = 0; i < NumCheckpoints; ++i)
+            {
+                const float Angle = 2.f * PI * i / NumCheckpoints;
+                const FVector Loc(FMath::Cos(Angle) * TrackRadius, FMath::Sin(Angle) * TrackRadius, 0.f);
+                const FRotator Rot(0.f, FMath::RadiansToDegrees(Angle) + 90.f, 0.f);
+
+                ACheckpoints* CP = World->SpawnActor<ACheckpoints>(Loc, Rot);
+                CP->CheckPointNo = i + 1;
+                CP->MaxCheckPoints = NumCheckpoints;
+                CP->bStartFinishLine = (i == 0);
+                Checkpoints.Add(CP);
+            }
+
+            FActorSpawnParameters CarParams;
+            CarParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+            for (int32 i = 0; i < NumCars; ++i)
+            {
+                const FVector Loc(TrackRadius - 2000.f + (i % 8) * 500.f, -(i / 8) * 800.f, 100.f);
+                if (AMyCar* Car = World->SpawnActor<AMyCar>(Loc, FRotator(0.f, 90.f, 0.f), CarParams))
+                {
+                    Cars.Add(Car);
+                }
+            }
+
+            for (int32 i = 0; i < NumCollectables; ++i)
+            {
+                const float Angle = 2.f * PI * (i + 0.5f) / NumCollectables;
+                const FVector Loc(FMath::Cos(Angle) * TrackRadius, FMath::Sin(Angle) * TrackRadius, 50.f);
+                Collectables.Add(World->SpawnActor<ACollectable>(Loc, FRotator::ZeroRotator));
+            }
+
+            // notes: no game mode -> subsystems first, then dispatch BeginPlay to every actor ourselves
+            World->BeginPlay();
+            World->GetWorldSettings()->NotifyBeginPlay();
+
+            return Cars.Num() == NumCars && GameState->GetTrackData() != nullptr;
+        }
+
+        void Destroy()
+        {
+            if (World)
+            {
+                GEngine->DestroyWorldContext(World);
+                World->DestroyWorld(/*bInformEngineOfWorld*/false);
+                World = nullptr;
+                CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            }
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // Budgets: Base + PerCar * N + PerPair * N^2 microseconds per iteration.
+    // PerPair is for work that is currently quadratic (ghost ignores every car).
+    // ------------------------------------------------------------------------
+    struct FBudget
+    {
+        double BaseUs = 0.0;
+        double PerCarUs = 0.0;
+        double PerPairUs = 0.0;
+
+        double For(int32 NumCars) const { return BaseUs + PerCarUs * NumCars + PerPairUs * NumCars * NumCars; }
+    };
+
+    struct FResult
+    {
+        double MedianUs = 0.0;
+        double MaxUs = 0.0;
+    };
+
+    static FResult Measure(int32 Iterations, TFunctionRef<void()> Setup, TFunctionRef<void()> Op)
+    {
+        TArray<double> Samples;
+        Samples.Reserve(Iterations);
+
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            Setup();
+            const uint64 Start = FPlatformTime::Cycles64();
+            Op();
+            Samples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0);
+        }
+
+        Samples.Sort();
+        FResult Result;
+        Result.MedianUs = Samples.Num() > 0 ? Samples[Samples.Num() / 2] : 0.0;
+        Result.MaxUs = Samples.Num() > 0 ? Samples.Last() : 0.0;
+        return Result;
+    }
+
+    static FString GetCsvPath() { return FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("RacePerf.csv"); }
+    static FString GetBaselinePath() { return FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("RacePerfBaseline.csv"); }
+
+    // notes: last MedianUs recorded for (Test, Cars) in the baseline file, < 0 if none
+    static double FindBaseline(const FString& TestName, int32 NumCars)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *GetBaselinePath()))
+        {
+            return -1.0;
+        }
+
+        double Baseline = -1.0;
+        for (const FString& Line : Lines)
+        {
+            TArray<FString> Cols;
+            Line.ParseIntoArray(Cols, TEXT(","), /*InCullEmpty*/false);
+            if (Cols.Num() >= 7 && Cols[1] == TestName && FCString::Atoi(*Cols[2]) == NumCars)
+            {
+                Baseline = FCString::Atod(*Cols[6]);
+            }
+        }
+        return Baseline;
+    }
+
+    static void AppendCsv(const FString& Row)
+    {
+        const FString Path = GetCsvPath();
+        if (!IFileManager::Get().FileExists(*Path))
+        {
+            FFileHelper::SaveStringToFile(FString(CsvHeader) + LINE_TERMINATOR, *Path);
+        }
+        FFileHelper::SaveStringToFile(Row + LINE_TERMINATOR, *Path, FFileHelper::EEncodingOptions::AutoDetect,
+            &IFileManager::Get(), FILEWRITE_Append);
+    }
+
+    // ------------------------------------------------------------------------
+    // One benchmark case: build the world, time Op, report + CSV + thresholds
+    // ------------------------------------------------------------------------
+    static bool RunCase(FAutomationTestBase& Test, const FString& TestName, const FString& Parameters,
+        const FBudget& Budget, TFunctionRef<void(FFixture&)> Setup, TFunctionRef<void(FFixture&)> Op)
+    {
+        const int32 NumCars = FCString::Atoi(*Parameters);
+        const int32 NumCollectables = NumCars * 2;
+        const int32 Iterations = NumCars >= 256 ? 10 : 30;
+
+        FFixture Fixture;
+        if (!Fixture.Create(NumCars, NumCollectables))
+        {
+            Test.AddError(FString::Printf(TEXT("Could not build a synthetic race with %d cars"), NumCars));
+            return false;
+        }
+
+        // warm caches / first-call allocations out of the measurement
+        Setup(Fixture);
+        Op(Fixture);
+
+        const FResult Result = Measure(Iterations, [&]() { Setup(Fixture); }, [&]() { Op(Fixture); });
+
+        float Tolerance = 0.25f;
+        FParse::Value(FCommandLine::Get(), TEXT("RacePerfTolerance="), Tolerance);
+
+        const double BudgetUs = Budget.For(NumCars);
+        const double BaselineUs = FindBaseline(TestName, NumCars);
+        const bool bOverBudget = Result.MedianUs > BudgetUs;
+        const bool bRegressed = BaselineUs > 0.0 && Result.MedianUs > BaselineUs * (1.0 + Tolerance);
+        const TCHAR* Verdict = bOverBudget ? TEXT("OverBudget") : (bRegressed ? TEXT("Regressed") : TEXT("Pass"));
+
+        AppendCsv(FString::Printf(TEXT("%s,%s,%d,%d,%d,%d,%.2f,%.2f,%.2f,%.2f,%s"),
+            *FDateTime::UtcNow().ToIso8601(), *TestName, NumCars, NumCheckpoints, NumCollectables, Iterations,
+            Result.MedianUs, Result.MaxUs, BudgetUs, BaselineUs, Verdict));
+
+        Test.AddInfo(FString::Printf(TEXT("%s %d cars: median %.1f us, max %.1f us (budget %.1f us, baseline %.1f us)"),
+            *TestName, NumCars, Result.MedianUs, Result.MaxUs, BudgetUs, BaselineUs));
+
+        if (bOverBudget)
+        {
+            Test.AddError(FString::Printf(TEXT("%s %d cars over budget: %.1f us > %.1f us"), *TestName, NumCars, Result.MedianUs, BudgetUs));
+        }
+        if (bRegressed)
+        {
+            Test.AddError(FString::Printf(TEXT("%s %d cars regressed: %.1f us vs baseline %.1f us (+%.0f%% allowed)"),
+                *TestName, NumCars, Result.MedianUs, BaselineUs, Tolerance * 100.f));
+        }
+        return !bOverBudget && !bRegressed;
+    }
+
+    static void GetCarCounts(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands)
+    {
+        for (const TCHAR* Count : { TEXT("8"), TEXT("64"), TEXT("256") })
+        {
+            OutBeautifiedNames.Add(FString::Printf(TEXT("%s cars"), Count));
+            OutTestCommands.Add(Count);
+        }
+    }
+
+    static void NoSetup(FFixture&) {}
+}
+
+#define RACE_PERF_TEST_FLAGS (EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// ============================================================================
+// Leaderboard
+// ============================================================================
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FRacePerfLeaderboardTest, "ArcDualDash.Perf.Leaderboard", RACE_PERF_TEST_FLAGS)
+
+void FRacePerfLeaderboardTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    RacePerf::GetCarCounts(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRacePerfLeaderboardTest::RunTest(const FString& Parameters)
+{
+    return RacePerf::RunCase(*this, TEXT("Leaderboard"), Parameters, { 50.0, 20.0, 0.0 },
+        RacePerf::NoSetup,
+        [](RacePerf::FFixture& F) { F.GameState->UpdateLeaderboard(); });
+}
+
+// ============================================================================
+// LapCheckpoint: every car crosses its next gate
+// ============================================================================
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FRacePerfLapCheckpointTest, "ArcDualDash.Perf.LapCheckpoint", RACE_PERF_TEST_FLAGS)
+
+void FRacePerfLapCheckpointTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    RacePerf::GetCarCounts(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRacePerfLapCheckpointTest::RunTest(const FString& Parameters)
+{
+    return RacePerf::RunCase(*this, TEXT("LapCheckpoint"), Parameters, { 20.0, 10.0, 0.0 },
+        RacePerf::NoSetup,
+        [](RacePerf::FFixture& F)
+        {
+            for (AMyCar* Car : F.Cars)
+            {
+                const int32 Next = Car->CurrentCheckpointIndex % RacePerf::NumCheckpoints + 1;
+                Car->LapCheckpoint(Next, RacePerf::NumCheckpoints, Next == 1);
+            }
+        });
+}
+
+// ============================================================================
+// Collectable pickup: each car takes one pickup (score + boost + consume)
+// ============================================================================
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FRacePerfCollectableTest, "ArcDualDash.Perf.CollectablePickup", RACE_PERF_TEST_FLAGS)
+
+void FRacePerfCollectableTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    RacePerf::GetCarCounts(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRacePerfCollectableTest::RunTest(const FString& Parameters)
+{
+    return RacePerf::RunCase(*this, TEXT("CollectablePickup"), Parameters, { 20.0, 15.0, 0.0 },
+        [](RacePerf::FFixture& F)
+        {
+            for (ACollectable* Collectable : F.Collectables)
+            {
+                FRacePerfTestAccess::ResetPickup(Collectable);
+            }
+        },
+        [](RacePerf::FFixture& F)
+        {
+            for (int32 i = 0; i < F.Cars.Num(); ++i)
+            {
+                FRacePerfTestAccess::Pickup(F.Collectables[i % F.Collectables.Num()], F.Cars[i]);
+            }
+        });
+}
+
+// ============================================================================
+// Crash + respawn: every car crashes and respawns at its baked slot
+// ============================================================================
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FRacePerfCrashRespawnTest, "ArcDualDash.Perf.CrashRespawn", RACE_PERF_TEST_FLAGS)
+
+void FRacePerfCrashRespawnTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    RacePerf::GetCarCounts(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRacePerfCrashRespawnTest::RunTest(const FString& Parameters)
+{
+    return RacePerf::RunCase(*this, TEXT("CrashRespawn"), Parameters, { 50.0, 80.0, 1.0 },
+        [](RacePerf::FFixture& F)
+        {
+            // respawn starts a ghost; clear it so every iteration does the same work
+            for (AMyCar* Car : F.Cars)
+            {
+                FRacePerfTestAccess::EndGhost(Car);
+            }
+        },
+        [](RacePerf::FFixture& F)
+        {
+            for (AMyCar* Car : F.Cars)
+            {
+                FRacePerfTestAccess::Crash(Car);
+                FRacePerfTestAccess::Respawn(Car);
+            }
+        });
+}
+
+// ============================================================================
+// Ghost toggle: every car enters and leaves ghost mode
+// ============================================================================
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FRacePerfGhostToggleTest, "ArcDualDash.Perf.GhostToggle", RACE_PERF_TEST_FLAGS)
+
+void FRacePerfGhostToggleTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    RacePerf::GetCarCounts(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FRacePerfGhostToggleTest::RunTest(const FString& Parameters)
+{
+    return RacePerf::RunCase(*this, TEXT("GhostToggle"), Parameters, { 20.0, 20.0, 1.0 },
+        RacePerf::NoSetup,
+        [](RacePerf::FFixture& F)
+        {
+            for (AMyCar* Car : F.Cars)
+            {
+                FRacePerfTestAccess::BeginGhost(Car);
+            }
+            for (AMyCar* Car : F.Cars)
+            {
+                FRacePerfTestAccess::EndGhost(Car);
+            }
+        });
+}
+
+// ============================================================================
+// Quiet lap: after green light a full lap (gates, pickups, crash + respawn,
+// ghost, world ticks) must not create a single UObject
+// ============================================================================
+namespace RacePerf
+{
+    // notes: creation can happen on loader threads; names only for the report
+    struct FObjectCreateCounter : public FUObjectArray::FUObjectCreateListener
+    {
+        std::atomic<int32> Count{ 0 };
+        FCriticalSection Lock;
+        TArray<FString> Names;
+
+        FObjectCreateCounter() { GUObjectArray.AddUObjectCreateListener(this); }
+        virtual ~FObjectCreateCounter() override { GUObjectArray.RemoveUObjectCreateListener(this); }
+
+        virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+        {
+            if (++Count <= 16)
+            {
+                FScopeLock ScopeLock(&Lock);
+                Names.Add(FString::Printf(TEXT("%s %s"), *Object->GetClass()->GetName(), *Object->GetFName().ToString()));
+            }
+        }
+
+        virtual void OnUObjectArrayShutdown() override { GUObjectArray.RemoveUObjectCreateListener(this); }
+    };
+
+    // notes: world ticks of one scripted lap, and how many ran outside the running / quiet race
+    struct FLapTicks
+    {
+        int32 Ticks = 0;
+        int32 ClockStopped = 0;
+        int32 NotQuiet = 0;
+    };
+
+    static FLapTicks RunScriptedLap(FFixture& F)
+    {
+        constexpr int32 TicksPerGate = 4;
+        const int32 Crasher = F.Cars.Num() / 2;
+        FLapTicks Result;
+
+        for (int32 Gate = 1; Gate <= NumCheckpoints + 1; ++Gate)
+        {
+            const int32 No = (Gate - 1) % NumCheckpoints + 1;
+            for (AMyCar* Car : F.Cars)
+            {
+                Car->LapCheckpoint(No, NumCheckpoints, No == 1);
+            }
+
+            // a quarter of the way round: one pickup per car, one crash + respawn (starts a ghost)
+            if (Gate == NumCheckpoints / 4)
+            {
+                for (int32 i = 0; i < F.Cars.Num(); ++i)
+                {
+                    FRacePerfTestAccess::Pickup(F.Collectables[i % F.Collectables.Num()], F.Cars[i]);
+                }
+                FRacePerfTestAccess::Crash(F.Cars[Crasher]);
+                FRacePerfTestAccess::Respawn(F.Cars[Crasher]);
+            }
+
+            for (int32 Tick = 0; Tick < TicksPerGate; ++Tick)
+            {
+                F.World->Tick(LEVELTICK_All, 1.f / 60.f);
+                ++Result.Ticks;
+                Result.ClockStopped += F.GameState->bTimerRunning ? 0 : 1;
+                Result.NotQuiet += F.GameState->IsQuietRace() ? 0 : 1;
+            }
+        }
+        FRacePerfTestAccess::EndGhost(F.Cars[Crasher]);
+        return Result;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRacePerfQuietLapTest, "ArcDualDash.Perf.QuietLap", RACE_PERF_TEST_FLAGS)
+
+bool FRacePerfQuietLapTest::RunTest(const FString& Parameters)
+{
+    URaceSettings* Settings = GetMutableDefault<URaceSettings>();
+    TGuardValue<bool> QuietGuard(Settings->bGCQuietRace, true);
+
+    RacePerf::FFixture Fixture;
+    if (!Fixture.Create(/*NumCars*/8, /*NumCollectables*/16))
+    {
+        AddError(TEXT("Could not build a synthetic race"));
+        return false;
+    }
+    // notes: nobody may finish before the measured lap is over (the podium ends the quiet window)
+    Fixture.GameState->TotalLaps = 100;
+
+    // --- warm-up lap: green light and first-use creation ---
+    RacePerf::RunScriptedLap(Fixture);
+    for (ACollectable* Collectable : Fixture.Collectables)
+    {
+        FRacePerfTestAccess::ResetPickup(Collectable);
+    }
+
+    int32 Created = 0;
+    TArray<FString> Names;
+    RacePerf::FLapTicks Lap;
+    {
+        RacePerf::FObjectCreateCounter Counter;
+        Lap = RacePerf::RunScriptedLap(Fixture);
+        Created = Counter.Count.load();
+        FScopeLock ScopeLock(&Counter.Lock);
+        Names = Counter.Names;
+    }
+
+    AddInfo(FString::Printf(TEXT("QuietLap: %d UObject(s) created during the lap"), Created));
+    for (const FString& Name : Names)
+    {
+        AddInfo(FString::Printf(TEXT("  created: %s"), *Name));
+    }
+    TestEqual(TEXT("Ticks of the measured lap with the race clock stopped"), Lap.ClockStopped, 0);
+    TestEqual(TEXT("Ticks of the measured lap outside the quiet race"), Lap.NotQuiet, 0);
+    TestEqual(TEXT("UObjects created during a quiet lap"), Created, 0);
+    return Created == 0 && Lap.ClockStopped == 0 && Lap.NotQuiet == 0;
+}
+
+// ============================================================================
+// Steady-state mallocs: once the race is rolling, the logic tick (race clock,
+// car steps, snapshot, leaderboard apply) must not touch the heap
+// ============================================================================
+#if RACE_MALLOC_COUNTER
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRacePerfSteadyStateMallocsTest, "ArcDualDash.Perf.SteadyStateMallocs", RACE_PERF_TEST_FLAGS)
+
+bool FRacePerfSteadyStateMallocsTest::RunTest(const FString& Parameters)
+{
+    // notes: -RaceMallocCounter installs it at startup; installing here is the late path (RaceMallocCounter.h)
+    if (!RaceMallocCounter::Install())
+    {
+        AddWarning(TEXT("Allocations cannot be counted on this platform; skipped"));
+        return true;
+    }
+
+    RacePerf::FFixture Fixture;
+    if (!Fixture.Create(/*NumCars*/64, /*NumCollectables*/128))
+    {
+        AddError(TEXT("Could not build a synthetic race"));
+        return false;
+    }
+
+    const URaceLogicSubsystem* Logic = Fixture.World->GetSubsystem<URaceLogicSubsystem>();
+    if (!Logic)
+    {
+        AddError(TEXT("No race logic subsystem in the synthetic world"));
+        return false;
+    }
+
+    // notes: the running-race path of every tick is what is measured; nobody may finish
+    Fixture.GameState->TotalLaps = 100;
+
+    // --- warm-up lap: green light, first leaderboard passes, pools and scratch buffers at full size ---
+    RacePerf::RunScriptedLap(Fixture);
+
+    // --- measured frames: cars keep crossing gates (between ticks) so the ranking keeps changing ---
+    constexpr int32 NumFrames = 240;
+    uint32 Total = 0;
+    uint32 Worst = 0;
+    int32 FramesWithMallocs = 0;
+    int32 FramesClockStopped = 0;
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        if (Frame % 8 == 0)
+        {
+            AMyCar* Car = Fixture.Cars[(Frame / 8) % Fixture.Cars.Num()];
+            const int32 Next = Car->CurrentCheckpointIndex % RacePerf::NumCheckpoints + 1;
+            Car->LapCheckpoint(Next, RacePerf::NumCheckpoints, Next == 1);
+        }
+
+        Fixture.World->Tick(LEVELTICK_All, 1.f / 60.f);
+        FramesClockStopped += Fixture.GameState->bTimerRunning ? 0 : 1;
+
+        const uint32 Mallocs = Logic->GetLastTickMallocs();
+        Total += Mallocs;
+        Worst = FMath::Max(Worst, Mallocs);
+        FramesWithMallocs += Mallocs > 0 ? 1 : 0;
+    }
+
+    AddInfo(FString::Printf(TEXT("SteadyStateMallocs: %u allocation(s) over %d frames, worst frame %u, %d frame(s) allocated"),
+        Total, NumFrames, Worst, FramesWithMallocs));
+    TestEqual(TEXT("Measured frames with the race clock stopped"), FramesClockStopped, 0);
+    TestEqual(TEXT("Heap allocations in the steady-state race tick"), (int32)Total, 0);
+    return Total == 0 && FramesClockStopped == 0;
+}
+
+#endif // RACE_MALLOC_COUNTER
+
+#undef RACE_PERF_TEST_FLAGS
+
+#endif // WITH_DEV_AUTOMATION_TESTS
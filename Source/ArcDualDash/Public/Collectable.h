@@ -4,6 +4,7 @@
 #include "GameFramework/Actor.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "RaceSignificanceSubsystem.h"
 #include "Collectable.generated.h"
 
 class AMyCar;
@@ -20,8 +21,13 @@ class ARCDUALDASH_API ACollectable : public AActor
 public:
 	ACollectable();
 
+	// notes: called by URaceSignificanceSubsystem when the bucket changes
+	void ApplySignificance(ERaceSignificance NewSignificance);
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// --- Components (visible as Inherited) ---
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Collectable", meta = (AllowPrivateAccess = "true"))
@@ -54,5 +60,19 @@ protected:
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
 		const FHitResult& SweepResult);
 
-	void ConsumePickup(); // notes: hide + disable + quick destroy
+	void ConsumePickup(); // notes: hide + disable (+ quick destroy outside a GC-quiet race)
+
+	// notes: only replicated state; actor stays dormant until this flips
+	UPROPERTY(ReplicatedUsing = OnRep_Consumed)
+	bool bConsumed = false;
+
+	UFUNCTION()
+	void OnRep_Consumed();
+
+	void ApplyConsumedState();
+
+	ERaceSignificance Significance = ERaceSignificance::High;
+
+	// automation perf tests drive pickups without physics overlaps
+	friend struct FRacePerfTestAccess;
 };
@@ -5,8 +5,12 @@
 #include "WheeledVehiclePawn.h"
 #include "InputActionValue.h"
 #include "ChaosVehicleMovementComponent.h"
+#include "RaceVehicleSubsystem.h"
+#include "RaceSignificanceSubsystem.h"
+#include <atomic>
 
 class UBoxComponent;
+class UNiagaraComponent;
 
 #include "MyCar.generated.h"
 
@@ -16,6 +20,17 @@ class UBoxComponent;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLapChangedLocal, int32, NewLap, int32, TotalLaps);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimeUpdatedLocal, float, NewTime);
 
+// ---------------------------------------------------------
+// Raw drive controls handed to the vehicle movement component
+// ---------------------------------------------------------
+struct FRaceDriveInput
+{
+	float Throttle = 0.f;   // -1..1 (negative reverses)
+	float Steering = 0.f;   // -1..1
+	float Brake = 0.f;      // 0..1
+	bool bHandbrake = false;
+};
+
 UCLASS()
 class ARCDUALDASH_API AMyCar : public AWheeledVehiclePawn
 {
@@ -24,16 +39,23 @@ class ARCDUALDASH_API AMyCar : public AWheeledVehiclePawn
 public:
 	AMyCar();
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
+	virtual void AsyncPhysicsTickActor(float DeltaTime, float SimTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
 
 	// --- Player Identity ---
-	UPROPERTY(BlueprintReadOnly, Category = "Race|Player")
+	UPROPERTY(BlueprintReadOnly, Replicated, Category = "Race|Player")
 	int32 PlayerID = 0;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Race|Player")
 	bool bIsAI = false;
 
+	// Server: drive itself along the guide line every logic step (headless race instances)
+	UPROPERTY(BlueprintReadOnly, Category = "Race|Player")
+	bool bLineDriver = false;
+
 	// --- Input (P1) ---
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
 	class UInputMappingContext* DefaultMappingContext;
@@ -49,22 +71,63 @@ public:
 	void OnHandbrakePressed();
 	void OnHandbrakeReleased();
 
-	// --- Race laps / checkpoints ---
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Race|Laps")
+	// --- Drive controls ---
+	// Player path: every P1 / P2 input handler ends here (recorded / suppressed by URaceReplaySubsystem)
+	void ApplyDriveInput(const FRaceDriveInput& Input);
+
+	// Raw path: AI, training harness and replay playback
+	void SetDriveInput(const FRaceDriveInput& Input);
+	const FRaceDriveInput& GetDriveInput() const { return DriveInput; }
+
+	// notes: back to the spawn transform, lap / checkpoint / timer / crash state cleared
+	void ResetRaceProgress();
+
+	bool IsCrashed() const { return bIsCrashed; }
+
+	// --- Race laps / checkpoints (server validated, replicated to clients) ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_LapProgress, Category = "Race|Laps")
 	int32 Lap = 1;
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Race|Laps")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_LapProgress, Category = "Race|Laps")
 	int32 CurrentCheckpointIndex = 0;
 
 	UFUNCTION(BlueprintCallable, Category = "Race|Laps")
 	void LapCheckpoint(int32 CheckpointNo, int32 MaxCheckpoint, bool bStartFinishLine);
 
-	// --- Leaderboard tracking ---
+	UFUNCTION()
+	void OnRep_LapProgress();
+
+	// --- Leaderboard tracking (updated on the fixed race logic step) ---
 	UPROPERTY(BlueprintReadOnly, Category = "Race|Progress")
 	float DistanceToNextCheckpoint = 0.f;
 
-	UPROPERTY()
-	TArray<ACheckpoints*> AllCheckpoints;
+	// One fixed-rate logic step (URaceLogicSubsystem): next-gate distance, local timer
+	void FixedRaceTick(float StepSeconds);
+
+	// DistanceToNextCheckpoint interpolated between the last two logic steps
+	UFUNCTION(BlueprintPure, Category = "Race|Progress")
+	float GetDisplayDistanceToNextCheckpoint() const;
+
+	// --- Timing at the last checkpoint (server: ARaceGameState interval table) ---
+	UPROPERTY(BlueprintReadOnly, Replicated, Category = "Race|Progress")
+	float GapToLeader = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Replicated, Category = "Race|Progress")
+	float IntervalToAhead = 0.f;
+
+	// Server: fastest completed lap this race (0 until the first lap is done)
+	UPROPERTY(BlueprintReadOnly, Category = "Race|Laps")
+	float BestLapTime = 0.f;
+
+	// --- Track limits (server, from the baked distance field; see URaceLogicSubsystem) ---
+	UPROPERTY(BlueprintReadOnly, Replicated, Category = "Race|TrackLimits")
+	bool bOffTrack = false;
+
+	UPROPERTY(BlueprintReadOnly, Replicated, Category = "Race|TrackLimits")
+	int32 TrackLimitCuts = 0;
+
+	// One logic step of off-track / cut bookkeeping; SignedDistance < 0 inside the track (cm)
+	void UpdateTrackLimits(float SignedDistance, float StepSeconds);
 
 	// --- Keyboard proxy for P2 ---
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input|P2")
@@ -88,6 +151,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PowerUp")
 	void EndSpeedBoost();
 
+	// --- Physics output for HUD (written on the physics step, read without blocking) ---
+	UFUNCTION(BlueprintPure, Category = "PowerUp")
+	bool IsBoostActive() const { return bPhysBoostActive.load(std::memory_order_relaxed); }
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	float GetPhysicsSpeed() const { return PhysSpeed.load(std::memory_order_relaxed); }
+
 	UFUNCTION(BlueprintCallable, Category = "Score")
 	int32 AddScore(int32 Delta);
 
@@ -100,8 +170,32 @@ public:
 	UPROPERTY(EditAnywhere, Category = "PowerUp")
 	float BoostDurationDefault = 2.5f;
 
+	// --- Slipstream (strength 0..1 set by URaceVehicleSubsystem each frame) ---
+	void SetSlipstream(float Strength) { SlipstreamStrength.store(Strength, std::memory_order_relaxed); }
+
+	UFUNCTION(BlueprintPure, Category = "Slipstream")
+	float GetSlipstream() const { return SlipstreamStrength.load(std::memory_order_relaxed); }
+
+	// fraction of aero drag kept at full draft (stacks with BoostDragScale via min)
+	UPROPERTY(EditAnywhere, Category = "Slipstream")
+	float SlipstreamDragScale = 0.7f;
+
+	// extra forward acceleration at full draft (cm/s^2)
+	UPROPERTY(EditAnywhere, Category = "Slipstream")
+	float SlipstreamAccel = 150.f;
+
 	void SetLastCheckpoint(AActor* CheckpointActor) { LastCheckpoint = CheckpointActor; }
 
+	// --- Simulation LOD (driven by URaceVehicleSubsystem) ---
+	void SetSimLOD(ERaceSimLOD NewLOD);
+	ERaceSimLOD GetSimLOD() const { return SimLOD; }
+
+	// AI only, not crashed, and the track has a centreline to follow
+	bool CanUseProxySim() const;
+
+	// --- Presentation significance (driven by URaceSignificanceSubsystem) ---
+	void ApplySignificance(ERaceSignificance NewSignificance);
+
 	// --- Local HUD events ---
 	UPROPERTY(BlueprintAssignable, Category = "HUD")
 	FOnLapChangedLocal OnLapChangedLocal;
@@ -112,13 +206,68 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "HUD")
 	float LocalElapsedTime = 0.f;
 
+	// LocalElapsedTime read off the race clock for this frame
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	float GetDisplayLocalElapsedTime() const;
+
 private:
+	// automation perf tests drive crash / respawn / ghost directly
+	friend struct FRacePerfTestAccess;
+
+	FRaceDriveInput DriveInput;
+
+	// --- Fixed-step interpolation (previous logic step) ---
+	float PrevDistanceToNextCheckpoint = 0.f;
+	int32 NextGateIndex = INDEX_NONE;
+	int32 PrevNextGateIndex = INDEX_NONE;
+
+	// --- Lap timing (server, ARaceGameState::GetRaceClock at each crossing) ---
+	float LapStartTime = 0.f;
+
+	// race time LocalElapsedTime counts from (0 = green light, moved by ResetRaceProgress)
+	float LocalStartTime = 0.f;
+	float GetLocalElapsedTimeNow() const;
+	bool bFinishedRace = false;
+
+	// --- Track limits (server) ---
+	float OffTrackTime = 0.f;
+	float OffTrackDriven = 0.f;			// cm driven since leaving the track
+	float OffTrackLapDistance = 0.f;	// distance along the centreline where the car left
+
+	// distance along the centreline, searched around the last gate passed
+	float GetLapDistance() const;
+	void ClearTrackLimitState();
+
 	// --- Boost internals ---
+	// Boost / drag relief / respawn nudge run on the fixed async physics step so the
+	// impulse is frame-rate independent. Game thread only posts requests here.
 	bool bBoostActive = false;
-	float SavedDragCoefficient = 0.f;
-	FTimerHandle BoostTimer;
 	int32 Score = 0;
 
+	// GT -> physics: request is published by bumping the sequence last
+	std::atomic<float> PendingBoostSeconds{ 0.f };
+	std::atomic<float> PendingBoostForce{ 0.f };
+	std::atomic<uint32> BoostRequestSeq{ 0 };
+	std::atomic<float> PendingRespawnNudge{ 0.f };
+	std::atomic<uint32> NudgeRequestSeq{ 0 };
+	std::atomic<float> SlipstreamStrength{ 0.f };
+
+	// physics -> GT
+	std::atomic<uint32> BoostAckSeq{ 0 };
+	std::atomic<bool> bPhysBoostActive{ false };
+	std::atomic<float> PhysSpeed{ 0.f };
+
+	// physics-thread only (snapshotted drag params + step state)
+	uint32 PT_BoostSeq = 0;
+	uint32 PT_NudgeSeq = 0;
+	float PT_BoostRemaining = 0.f;
+	float PT_BoostForce = 0.f;
+	float PT_DragCoefficient = 0.f;
+	float PT_DragAreaM2 = 0.f;
+	float PT_BoostDragScale = 1.f;
+	float PT_SlipstreamDragScale = 1.f;
+	float PT_SlipstreamAccel = 0.f;
+
 	// --- Crash + Respawn ---
 	UFUNCTION()
 	void OnCarHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
@@ -135,9 +284,30 @@ private:
 	UFUNCTION()
 	void HandleCarCrash();
 
+	UFUNCTION()
+	void OnRep_IsCrashed();
+
+	void PlayCrashFX();
+
 	UFUNCTION()
 	void RespawnCar();
 
+	// notes: pooled looping trail (URaceFXPoolSubsystem), handed back when the boost ends
+	UPROPERTY(Transient)
+	UNiagaraComponent* BoostTrailFX = nullptr;
+
+	// Server: boost is on; clients acquire / release their own trail from it
+	UPROPERTY(ReplicatedUsing = OnRep_BoostTrail)
+	bool bBoostTrail = false;
+
+	UFUNCTION()
+	void OnRep_BoostTrail();
+
+	void SetBoostTrail(bool bOn);
+	void UpdateBoostTrail();
+	void ReleaseBoostTrail();
+
+	// notes: legacy Cascade explosion, only used while URaceSettings::ExplosionFX names no Niagara system
 	UPROPERTY(EditAnywhere, Category = "Crash|Effects")
 	UParticleSystem* ExplosionFX = nullptr;
 
@@ -150,7 +320,7 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Crash|Settings")
 	float RespawnDelay = 2.0f;
 
-	UPROPERTY()
+	UPROPERTY(ReplicatedUsing = OnRep_IsCrashed)
 	bool bIsCrashed = false;
 
 	UPROPERTY()
@@ -177,12 +347,49 @@ private:
 
 	bool bIsGhost = false;
 
+	// reused every crash / respawn instead of a fresh local handle each time
+	FTimerHandle RespawnTimerHandle;
+	FTimerHandle GhostTimerHandle;
+
 	bool FindSafeRespawnSpot(const FVector& BaseLoc, const FRotator& BaseRot, FVector& OutLoc) const;
 	int32 GetRespawnSlot() const;
 
 	void BeginGhost();
 	void EndGhost();
 
+	// --- Sim LOD / kinematic proxy ---
+	UPROPERTY(EditAnywhere, Category = "Vehicle LOD")
+	float ProxyMinSpeed = 1500.f;
+
+	ERaceSimLOD SimLOD = ERaceSimLOD::Full;
+	ERaceSignificance Significance = ERaceSignificance::High;
+	float ProxyDistance = 0.f;
+	float ProxySpeed = 0.f;
+	FVector2D ProxyOffset = FVector2D::ZeroVector; // (right, up) offset from the line at demotion
+
+	void EnterProxySim();
+	void ExitProxySim();
+	void TickProxySim(float DeltaSeconds);
+	void ApplyTickInterval(float Interval);
+
+	// --- Line driver (bLineDriver): pure pursuit on the guide line, bang-bang speed ---
+	// seconds of travel ahead of the car to aim at
+	UPROPERTY(EditAnywhere, Category = "Line Driver")
+	float LineDriverLookAhead = 1.f;
+
+	// cm/s on tracks without a baked racing line (eased off in corners)
+	UPROPERTY(EditAnywhere, Category = "Line Driver")
+	float LineDriverCruiseSpeed = 2500.f;
+
+	// respawn after this long below walking pace
+	UPROPERTY(EditAnywhere, Category = "Line Driver")
+	float LineDriverStuckSeconds = 4.f;
+
+	int32 LineDriverSegment = INDEX_NONE;
+	float LineDriverStuckTime = 0.f;
+
+	void TickLineDriver(float StepSeconds);
+
 	// Optional trigger for overlap detection
 	UPROPERTY(EditAnywhere, Category = "Crash|Components")
 	class UBoxComponent* CrashTrigger = nullptr;
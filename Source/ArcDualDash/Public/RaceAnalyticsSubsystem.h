@@ -0,0 +1,122 @@
+#pragma once
+
+// ============================================================================
+// RaceAnalyticsSubsystem.h
+// purpose: double-buffered car snapshots + leaderboard analytics off the game
+//          thread. Every race logic step the game thread copies the state of
+//          all cars into a compact FRaceSnapshot; every LeaderboardInterval a
+//          task ranks that snapshot (lap -> checkpoint -> distance), works out
+//          race distance, position changes and field stats (time gaps come
+//          from the checkpoint interval table, see RaceIntervalTable). The result is applied to
+//          ARaceGameState on a later step (next frame at the earliest).
+// why: ranking and stats grow with car count and nothing on the game
+//      thread needs them within the same step.
+// notes: server only (clients rebuild the leaderboard from replication).
+//        The task only reads the snapshot it was launched with; the game
+//        thread always writes the other buffer. Flush() = blocking pass for
+//        callers that need an up-to-date ranking right now.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "RaceGameState.h"
+#include "RaceAnalyticsSubsystem.generated.h"
+
+class AMyCar;
+
+// one car at one logic step; Car is a key only, never resolved off the game thread
+struct FRaceCarSnapshot
+{
+    TWeakObjectPtr<AMyCar> Car;
+    int32 PlayerID = 0;
+    FVector3f Location = FVector3f::ZeroVector;
+    FQuat4f Rotation = FQuat4f::Identity;
+    FVector3f Velocity = FVector3f::ZeroVector;
+    int32 Lap = 0;
+    int32 Checkpoint = 0;
+    float DistanceToNext = 0.f;
+};
+
+struct FRaceSnapshot
+{
+    uint64 StepCount = 0;
+    float RaceTime = 0.f;
+    TArray<FRaceCarSnapshot> Cars;
+};
+
+struct FRaceStanding
+{
+    TWeakObjectPtr<AMyCar> Car;
+    int32 Lap = 0;
+    int32 Checkpoint = 0;
+    float DistanceToNext = 0.f;
+    float Progress = 0.f;       // race distance (cm)
+};
+
+struct FRacePositionChange
+{
+    TWeakObjectPtr<AMyCar> Car;
+    int32 OldPosition = 0;
+    int32 NewPosition = 0;
+};
+
+struct FRaceAnalytics
+{
+    uint64 StepCount = 0;
+    TArray<FRaceStanding> Standings;
+    TArray<FRacePositionChange> PositionChanges;
+    FRaceStats Stats;
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceAnalyticsSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static URaceAnalyticsSubsystem* Get(const UObject* WorldContext);
+
+    virtual void Deinitialize() override;
+
+    // notes: once per logic step after the cars (URaceLogicSubsystem); applies a
+    //        finished pass, publishes a new snapshot and launches the next pass when due
+    void PublishSnapshot(uint64 StepCount);
+
+    // notes: waits for the pass in flight, then ranks the current state inline
+    void Flush();
+
+    // notes: last published snapshot (game thread)
+    const FRaceSnapshot& GetLatestSnapshot() const { return Snapshots[LatestIndex]; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FTrackInfo
+    {
+        TArray<float> GateDistances;
+        float Length = 0.f;
+    };
+
+    ARaceGameState* GetAuthorityGameState();
+    bool CacheTrack(const ARaceGameState& GS);
+    int32 CaptureSnapshot(const ARaceGameState& GS, uint64 StepCount);
+    void ApplyFinishedPass();
+
+    static void Compute(const FRaceSnapshot& Snapshot, const FTrackInfo& Track,
+        TMap<TWeakObjectPtr<AMyCar>, int32>& PreviousPositions, int32& NumPositionChanges, FRaceAnalytics& Out);
+
+    FRaceSnapshot Snapshots[2];
+    int32 LatestIndex = 0;
+    int32 TaskIndex = INDEX_NONE;
+    uint64 LastPassStep = 0;
+
+    // --- owned by the task while it is in flight ---
+    UE::Tasks::FTask Task;
+    FRaceAnalytics Result;
+    TMap<TWeakObjectPtr<AMyCar>, int32> PreviousPositions;
+    int32 NumPositionChanges = 0;
+
+    // notes: copied once from the track data; the task never touches UObjects
+    FTrackInfo Track;
+};
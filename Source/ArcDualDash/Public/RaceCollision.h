@@ -0,0 +1,56 @@
+#pragma once
+
+// ============================================================================
+// RaceCollision.h
+// purpose: race object channels and collision profiles (DefaultEngine.ini),
+//          plus overlap counters for race.OverlapStats.
+//            RaceGate     ECC_GameTraceChannel1  checkpoint volumes
+//            Pickup       ECC_GameTraceChannel2  collectable spheres
+//            RaceCar      ECC_GameTraceChannel3  car bodies
+//            CrashSensor  ECC_GameTraceChannel4  car crash triggers
+// why: gates, crash triggers and pickups used to overlap every channel, so
+//      each of them paired with the world and with each other. Response matrix
+//      now (everything else ignores):
+//            RaceGate    <-> RaceCar / Vehicle  overlap
+//            Pickup      <-> RaceCar / Vehicle  overlap
+//            CrashSensor <-> RaceCar / world    overlap
+//            RaceCar     <-> RaceCar / world    block
+// used by: ACheckpoints, ACollectable, AMyCar (profiles + counters).
+// notes: channel 1 keeps its old slot (was "Checkpoint", redirected), so
+//        levels saved with per-instance overrides stay valid.
+//        Migration: gates / pickups still overlap Vehicle and channels 1 + 2
+//        still default to Overlap, as before, so car Blueprints with their own
+//        Vehicle-type collision keep triggering them. Once BP_MyCar and the
+//        levels are resaved on the RaceCar profile, drop both.
+// console: race.OverlapStats  -> overlap pairs per profile + events per frame
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+#define ECC_RaceGate    ECC_GameTraceChannel1
+#define ECC_RacePickup  ECC_GameTraceChannel2
+#define ECC_RaceCar     ECC_GameTraceChannel3
+#define ECC_CrashSensor ECC_GameTraceChannel4
+
+enum class ERaceOverlapSource : uint8
+{
+    Gate,
+    Pickup,
+    CrashSensor,
+    MAX
+};
+
+namespace RaceCollision
+{
+    const FName GateProfile(TEXT("RaceGate"));
+    const FName PickupProfile(TEXT("Pickup"));
+    const FName CarProfile(TEXT("RaceCar"));
+    const FName CrashSensorProfile(TEXT("CrashSensor"));
+
+    // notes: game thread; one per begin-overlap handler call
+    ARCDUALDASH_API void CountOverlapEvent(ERaceOverlapSource Source);
+
+    // notes: overlap pairs of every overlap-generating primitive in World, grouped by
+    //        profile, and handler events per frame since the previous report
+    ARCDUALDASH_API void PrintOverlapStats(UWorld* World, FOutputDevice& Ar);
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+// ============================================================================
+// RaceEventBus.h
+// purpose: typed race event bus. Gameplay code emits fixed-size FRaceEvent
+//          records into a bounded lock-free MPSC ring; once per frame the
+//          game thread drains the ring into one immutable batch and fans it
+//          out to every consumer:
+//            game thread  OnRaceEvent (HUD / Blueprint) + AddConsumer(GameThread)
+//            workers      AddConsumer(Worker): one task per batch per consumer,
+//                         chained so each consumer sees batches in order
+//          Built in: stats (race.EventStats) and logging (race.LogEvents 1),
+//          both on workers.
+// why: emit cost is one ring slot regardless of how many observers there are;
+//      consumers never run inside the gameplay paths (overlaps, crashes, boost).
+// notes: ring full -> event dropped and counted, producers never block.
+//        Producers may be any thread (game thread, async physics).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "RaceEventBus.generated.h"
+
+class AMyCar;
+
+UENUM(BlueprintType)
+enum class ERaceEventType : uint8
+{
+    CheckpointCrossed,  // Value = checkpoint index reached
+    LapCompleted,       // Value = new lap
+    Pickup,             // Value = score granted, Amount = boost seconds (0 = none)
+    Crash,
+    Respawn,
+    BoostStart,         // Amount = boost seconds
+    BoostEnd,
+    OffTrack,           // Value = 1 left the track / 0 rejoined, Amount = seconds off (on rejoin)
+    TrackCut,           // Value = cuts so far, Amount = cm gained beyond the distance driven
+    MAX UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FRaceEvent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Events")
+    ERaceEventType Type = ERaceEventType::MAX;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Events")
+    int32 PlayerID = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Events")
+    int32 Value = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Events")
+    float Amount = 0.f;
+
+    // notes: world time of the emit (seconds)
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Events")
+    float Time = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Events")
+    FVector3f Location = FVector3f::ZeroVector;
+
+    // notes: GUObjectArray index of the car; resolve on the game thread only
+    uint32 CarIndex = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Bounded MPSC ring (Vyukov): producers claim a slot with one CAS, publish by
+// bumping the slot sequence; the single consumer pops in order.
+// ---------------------------------------------------------------------------
+template <typename T>
+class TRaceMPSCRing
+{
+public:
+    void Init(uint32 InCapacity)
+    {
+        const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2u));
+        Mask = Capacity - 1;
+        Slots = MakeUnique<FSlot[]>(Capacity);
+        for (uint32 i = 0; i < Capacity; ++i)
+        {
+            Slots[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+        Tail.store(0, std::memory_order_relaxed);
+        Head = 0;
+    }
+
+    // any thread; false when full
+    bool Push(const T& Item)
+    {
+        uint64 Pos = Tail.load(std::memory_order_relaxed);
+        FSlot* Slot;
+        for (;;)
+        {
+            Slot = &Slots[Pos & Mask];
+            const uint64 Seq = Slot->Sequence.load(std::memory_order_acquire);
+            const int64 Diff = (int64)Seq - (int64)Pos;
+            if (Diff == 0)
+            {
+                if (Tail.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Pos = Tail.load(std::memory_order_relaxed);
+            }
+        }
+        Slot->Item = Item;
+        Slot->Sequence.store(Pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer thread only
+    bool Pop(T& Out)
+    {
+        FSlot& Slot = Slots[Head & Mask];
+        if (Slot.Sequence.load(std::memory_order_acquire) != Head + 1)
+        {
+            return false;
+        }
+        Out = Slot.Item;
+        Slot.Sequence.store(Head + Mask + 1, std::memory_order_release);
+        ++Head;
+        return true;
+    }
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence{ 0 };
+        T Item;
+    };
+
+    TUniquePtr<FSlot[]> Slots;
+    uint64 Mask = 0;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Tail{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) uint64 Head = 0;
+};
+
+enum class ERaceEventThread : uint8
+{
+    GameThread,
+    Worker,
+};
+
+using FRaceEventConsumer = TFunction<void(TConstArrayView<FRaceEvent>)>;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRaceEvent, const FRaceEvent&, Event);
+
+UCLASS()
+class ARCDUALDASH_API URaceEventBusSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // notes: gameplay entry point; cost is one ring push whatever is subscribed
+    static void Emit(const AMyCar* Car, ERaceEventType Type, int32 Value = 0, float Amount = 0.f);
+
+    // notes: returns a handle for RemoveConsumer; worker consumers must be thread-safe
+    //        with respect to anything they share with the game thread
+    int32 AddConsumer(ERaceEventThread Thread, FRaceEventConsumer Consumer);
+    void RemoveConsumer(int32 Handle);
+
+    // game thread, once per drained event (HUD widgets)
+    UPROPERTY(BlueprintAssignable, Category = "Race|Events")
+    FOnRaceEvent OnRaceEvent;
+
+    uint64 GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed); }
+    void PrintStats() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FConsumerEntry
+    {
+        int32 Handle = 0;
+        ERaceEventThread Thread = ERaceEventThread::GameThread;
+        TSharedPtr<FRaceEventConsumer> Fn;
+        UE::Tasks::FTask LastTask;
+    };
+
+    void Push(const FRaceEvent& Event);
+
+    TRaceMPSCRing<FRaceEvent> Ring;
+    TArray<FConsumerEntry> Consumers;
+    int32 NextHandle = 1;
+
+    std::atomic<uint64> NumDropped{ 0 };
+
+    // --- built-in consumers (stats counters are written by their worker task only) ---
+    std::atomic<uint64> EventCounts[(int32)ERaceEventType::MAX] = {};
+    int32 StatsHandle = 0;
+    int32 LogHandle = 0;
+};
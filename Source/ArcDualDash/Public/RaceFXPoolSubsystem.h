@@ -0,0 +1,80 @@
+#pragma once
+
+// ============================================================================
+// RaceFXPoolSubsystem.h
+// purpose: fixed pools of Niagara components (explosion, boost trail, pickup)
+//          created + warmed when the world begins play and reused round-robin.
+//          Per-frame spawn cap + per-viewport distance / frustum culling.
+//          Idle components are handed out first; a one-shot still playing
+//          may be stolen, a looping effect attached to a car never is.
+// why: pile-ups used to create several emitters + components in one frame,
+//      exactly when the frame is already the most expensive.
+// used by: AMyCar (crash, boost trail), ACollectable (pickup).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RaceFXPoolSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+class USceneComponent;
+
+UENUM(BlueprintType)
+enum class ERaceFX : uint8
+{
+    Explosion,
+    BoostTrail,
+    Pickup,
+    MAX UMETA(Hidden)
+};
+
+USTRUCT()
+struct FRaceFXPool
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<UNiagaraComponent*> Components;
+
+    // notes: parallel to Components; the scene component a looping effect is attached
+    //        to, cleared by ReleaseFX. Set = in use, never stolen.
+    TArray<TWeakObjectPtr<USceneComponent>> Holders;
+
+    int32 Next = 0;
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceFXPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // notes: returns null when capped / culled / no asset / every component held;
+    //        AttachTo keeps looping FX on a car and holds the component until ReleaseFX
+    UNiagaraComponent* SpawnFX(ERaceFX Type, const FVector& Location, const FRotator& Rotation,
+        USceneComponent* AttachTo = nullptr);
+
+    // notes: stop a looping effect; particles finish naturally, component stays pooled.
+    //        Ignored unless Holder is still the AttachTo the component was spawned with.
+    void ReleaseFX(UNiagaraComponent* Component, const USceneComponent* Holder);
+
+    // notes: false when the settings name no Niagara system for Type (nothing prewarmed)
+    bool HasPool(ERaceFX Type) const { return Pools[(int32)Type].Components.Num() > 0; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void PrewarmPool(ERaceFX Type, const TSoftObjectPtr<UNiagaraSystem>& SystemRef, int32 Size);
+    bool PassesCulling(ERaceFX Type, const FVector& Location) const;
+    int32 ClaimComponent(FRaceFXPool& Pool) const;
+
+    UPROPERTY()
+    FRaceFXPool Pools[(int32)ERaceFX::MAX];
+
+    uint64 SpawnFrame = 0;
+    int32 SpawnsThisFrame = 0;
+};
@@ -5,6 +5,9 @@
 // purpose: split-screen + spawn points for P1/P2.
 // why: packaged build won't remember PIE player count; I create LocalPlayer #2.
 // used by: level startup; PlayerStart tags ("P1", "P2").  KM
+// online: listen/dedicated server skips the local P2; every client is one car.
+//         loopback test:  server  "<map>?listen -game" (or ArcDualDashServer)
+//                         clients "127.0.0.1 -game"
 // ============================================================================
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
@@ -19,6 +22,7 @@ public:
     ARaceGameMode(); // notes: keep ctor light; defaults via Project Settings. KM
 
 protected:
+    virtual void StartPlay() override; // notes: kicks race preload + times actor BeginPlay
     virtual void BeginPlay() override; // notes: create LocalPlayer#2 once. KM
     virtual AActor* ChoosePlayerStart_Implementation(AController* Player) override; // notes: pick by tag. KM
 
@@ -2,16 +2,24 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameStateBase.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "RaceIntervalTable.h"
+#include "RaceTrackLine.h"
 #include "RaceGameState.generated.h"
 
 // Forward declarations
 class AMyCar;
 class ACheckpoints;
+class ARaceGameState;
+class URaceTrackData;
+class URaceLineData;
+struct FRaceAnalytics;
 
 // Delegates
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimeUpdated, float, NewTime);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLapChanged, int32, NewLap, int32, TotalLaps);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLeaderboardUpdated);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRacePositionChanged, AMyCar*, Car, int32, OldPosition, int32, NewPosition);
 
 // Struct for race data
 USTRUCT(BlueprintType)
@@ -31,13 +39,107 @@ struct FPlayerRaceData
 	UPROPERTY(BlueprintReadWrite)
 	int32 Checkpoint = 0;
 
-	// Combined progress key (laps + checkpoints + fractional segment)
+	// Race distance in laps (completed laps + fraction of the current one)
 	UPROPERTY(BlueprintReadWrite)
 	float ProgressKey = 0.f;
 
 	// Distance to next checkpoint (used as tie-breaker)
 	UPROPERTY(BlueprintReadWrite)
 	float DistanceToNext = 0.f;
+
+	// Seconds behind the leader at the car's last checkpoint
+	UPROPERTY(BlueprintReadWrite)
+	float GapToLeader = 0.f;
+
+	// Seconds behind the car ahead at the car's last checkpoint
+	UPROPERTY(BlueprintReadWrite)
+	float IntervalToAhead = 0.f;
+};
+
+// Field statistics from the last leaderboard pass (server only)
+USTRUCT(BlueprintType)
+struct FRaceStats
+{
+	GENERATED_BODY()
+
+	// cm/s
+	UPROPERTY(BlueprintReadOnly)
+	float AverageSpeed = 0.f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float TopSpeed = 0.f;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 TopSpeedPlayerID = 0;
+
+	// Race distance between the leader and the last car (cm)
+	UPROPERTY(BlueprintReadOnly)
+	float FieldSpread = 0.f;
+
+	// Position changes since the race started
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumPositionChanges = 0;
+};
+
+// Replicated leaderboard row (server -> clients). Quantized so an unchanged
+// row costs nothing and a changed one only a few bytes.
+USTRUCT()
+struct FRaceLeaderboardEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AMyCar* Car = nullptr;
+
+	UPROPERTY()
+	uint8 Position = 0;
+
+	UPROPERTY()
+	uint8 Lap = 0;
+
+	UPROPERTY()
+	uint8 Checkpoint = 0;
+
+	// Distance to next checkpoint in whole metres (tie-breaker only)
+	UPROPERTY()
+	uint16 DistanceToNextM = 0;
+
+	// ProgressKey in thousandths of a lap (clamped at 65.535 laps)
+	UPROPERTY()
+	uint16 ProgressMilliLaps = 0;
+
+	bool HasSameProgress(const FRaceLeaderboardEntry& Other) const
+	{
+		return Position == Other.Position && Lap == Other.Lap
+			&& Checkpoint == Other.Checkpoint && DistanceToNextM == Other.DistanceToNextM
+			&& ProgressMilliLaps == Other.ProgressMilliLaps;
+	}
+};
+
+USTRUCT()
+struct FRaceLeaderboardArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FRaceLeaderboardEntry> Items;
+
+	// Not replicated: lets client callbacks reach the game state
+	UPROPERTY(NotReplicated)
+	ARaceGameState* Owner = nullptr;
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FRaceLeaderboardEntry, FRaceLeaderboardArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FRaceLeaderboardArray> : public TStructOpsTypeTraitsBase2<FRaceLeaderboardArray>
+{
+	enum { WithNetDeltaSerializer = true };
 };
 
 UCLASS()
@@ -49,7 +151,8 @@ public:
 	ARaceGameState();
 
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// --- Delegates for UI ---
 	UPROPERTY(BlueprintAssignable, Category = "Events")
@@ -61,26 +164,61 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnLeaderboardUpdated OnLeaderboardUpdated;
 
+	// Server only: fired once per car that moved since the previous leaderboard pass
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnRacePositionChanged OnPositionChanged;
+
 	// --- Race data ---
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Race")
 	int32 TotalLaps = 3;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Race")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_CurrentLap, Category = "Race")
 	int32 CurrentLap = 1;
 
+	// Local value: server world time since RaceStartServerTime (synced on clients), refreshed every logic step
 	UPROPERTY(BlueprintReadOnly, Category = "Race")
 	float ElapsedTime = 0.f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Race")
 	bool bTimerRunning = true;
 
+	// One fixed-rate logic step (URaceLogicSubsystem): race clock
+	void FixedRaceTick(float StepSeconds, uint64 StepCount);
+
+	// Race clock for this frame (ElapsedTime is as of the last logic step)
+	UFUNCTION(BlueprintPure, Category = "Race")
+	float GetDisplayElapsedTime() const;
+
+	// Server world time since the race clock started, read now (not clamped to a stopped clock)
+	float GetRaceClock() const;
+
 	// --- Leaderboard ---
+	// Local sorted view (server: ranked by URaceAnalyticsSubsystem, clients: rebuilt from ReplicatedLeaderboard)
 	UPROPERTY(BlueprintReadOnly, Category = "Leaderboard")
 	TArray<FPlayerRaceData> Leaderboard;
 
+	UPROPERTY(BlueprintReadOnly, Category = "Leaderboard")
+	FRaceStats RaceStats;
+
+	// Blocking re-rank of the current state; the periodic one runs on a worker
 	UFUNCTION(BlueprintCallable, Category = "Leaderboard")
 	void UpdateLeaderboard();
 
+	// Server, game thread: publish a finished analytics pass (leaderboard, replication, events)
+	void ApplyRaceAnalytics(const FRaceAnalytics& Analytics);
+
+	// Server: stamp Car's pass of its current checkpoint, set its gap / interval
+	void RecordCheckpointPass(AMyCar& Car);
+
+	// Server: a car completed its last lap; returns its finishing position (1-based).
+	// The race clock stops (podium) once all NumCars have finished.
+	int32 RegisterFinish(int32 NumCars);
+
+	static FString MakePlayerName(const AMyCar* Car);
+
+	// Same name into a caller-owned buffer (no heap allocation for a stack builder)
+	static void BuildPlayerName(const AMyCar* Car, FStringBuilderBase& Out);
+
 	UFUNCTION(BlueprintCallable, Category = "Race")
 	void IncrementLapAndBroadcast();
 
@@ -90,15 +228,72 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Race")
 	void StopTimer();
 
+	// Client side: rebuild Leaderboard after a fast-array update
+	void HandleLeaderboardReplicated();
+
+	// Between green light and podium with automatic GC deferred
+	bool IsQuietRace() const { return bQuietRace; }
+
+	// Baked track layout (gates, centreline, respawn slots, sectors); null before BeginPlay
+	const URaceTrackData* GetTrackData() const { return TrackData; }
+
+	// Centreline through the ordered checkpoints (empty if the track has none)
+	const FRaceTrackLine& GetTrackLine() const;
+
+	// Baked racing line + speed targets; null if the track has none (RaceLineBake)
+	const URaceLineData* GetRacingLine() const { return RacingLine; }
+
+	// Line AI guidance follows: the racing line if baked, else the centreline
+	const FRaceTrackLine& GetGuideLine() const;
+
 private:
-	FTimerHandle LeaderboardTimerHandle;
+	// --- Replication ---
+	UPROPERTY(Replicated)
+	FRaceLeaderboardArray ReplicatedLeaderboard;
+
+	// Server world time the race clock was (re)started / stopped; clients derive ElapsedTime from these
+	UPROPERTY(Replicated)
+	float RaceStartServerTime = 0.f;
+
+	UPROPERTY(Replicated)
+	float RaceEndServerTime = 0.f;
+
+	UFUNCTION()
+	void OnRep_CurrentLap();
+
+	void SyncReplicatedLeaderboard();
+
+	// Leaderboard[Row] for Car: swaps Car's previous row into place (or grows the
+	// array) so rows and their name strings are reused across updates, and refreshes the name
+	FPlayerRaceData& ClaimLeaderboardRow(int32 Row, AMyCar* Car);
+
+	// Loads <Map>_Track, or bakes a transient copy from the placed checkpoints
+	void LoadTrackData();
+
+	UPROPERTY()
+	URaceTrackData* TrackData = nullptr;
+
+	// GC-quiet race (URaceSettings::bGCQuietRace): defer automatic GC at green light, collect at the podium
+	// (last car finished)
+	void BeginQuietRace();
+	void EndQuietRace();
+
+	bool bQuietRace = false;
+
+	// Loads <Map>_Line if it was baked; no runtime fallback (the optimisation is offline work)
+	void LoadRacingLine();
 
-	// Cached checkpoints
 	UPROPERTY()
-	TArray<AActor*> TrackCheckpoints;
+	URaceLineData* RacingLine = nullptr;
 
 	int32 NumCheckpoints = 0;
 
+	// Pass times per (lap % window, gate); reset with the race clock
+	FRaceIntervalTable IntervalTable;
+
+	// Cars past the finish line since the race clock started
+	int32 NumFinished = 0;
+
 	// Helper function for fractional progress along checkpoint segment
 	static float CalculateSegmentT(const FVector& A, const FVector& B, const FVector& P)
 	{
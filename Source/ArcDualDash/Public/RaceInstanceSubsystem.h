@@ -0,0 +1,90 @@
+#pragma once
+
+// ============================================================================
+// RaceInstanceSubsystem.h
+// purpose: hosts K independent race worlds in one headless process for AI
+//          evaluation / load testing. Each instance is its own Game world
+//          (own physics scene, game mode, ARaceGameState, cars and race
+//          subsystems) with the track map streamed in as a level instance.
+// run:     ArcDualDashServer <lobby map> -nullrhi -RaceInstances=K
+//              [-RaceInstanceMap=/Game/Maps/Track] [-RaceInstanceCars=N]
+// output:  Saved/RaceInstances/Results.csv, one row per car per instance,
+//          written once every instance finished or timed out.
+// notes:   instance cars drive themselves along the guide line (AMyCar::bLineDriver):
+//          a baseline driver for load testing, not a competitive AI.
+//          The engine ticks every Game world context each frame. World ticks
+//          are game-thread serial (UE world tick is not re-entrant); the
+//          per-world Chaos solvers are what run across cores.
+//          Instance maps must be non World Partition (level instance load).
+// console: race.Instances
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RaceInstanceSubsystem.generated.h"
+
+class AMyCar;
+
+USTRUCT()
+struct FRaceInstance
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<UWorld> World = nullptr;
+
+    UPROPERTY()
+    TArray<TObjectPtr<AMyCar>> Cars;
+
+    double StartTime = 0.0;
+    double EndTime = 0.0;
+    bool bFinished = false;
+    bool bTimedOut = false;
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceInstanceSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static URaceInstanceSubsystem* Get(const UObject* WorldContext);
+
+    // notes: only exists with -RaceInstances=K on the command line
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // notes: true for worlds created here; game mode skips local players / preload for them
+    static bool IsInstanceWorld(const UWorld* World);
+
+    int32 NumInstances() const { return Instances.Num(); }
+    UWorld* GetInstanceWorld(int32 Index) const { return Instances[Index].World; }
+    const FRaceInstance& GetInstance(int32 Index) const { return Instances[Index]; }
+
+    // notes: AI cars on the baked grid (rows of respawn slots, backwards from the start line)
+    static void SpawnGridCars(UWorld* World, int32 NumCars, TArray<AMyCar*>& OutCars);
+
+    void PrintStatus() const;
+
+private:
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+    bool CreateInstance(int32 Index);
+    void DestroyInstances();
+
+    // notes: polled from the core ticker; finished = race clock stopped
+    bool TickInstances(float DeltaTime);
+    void WriteResults() const;
+
+    UPROPERTY()
+    TArray<FRaceInstance> Instances;
+
+    FString MapPackageName;
+    int32 RequestedInstances = 0;
+    int32 CarsPerInstance = 0;
+    bool bResultsWritten = false;
+
+    FDelegateHandle PostLoadMapHandle;
+    FTSTicker::FDelegateHandle TickerHandle;
+    IConsoleObject* StatusCommand = nullptr;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+// ============================================================================
+// RaceIntervalTable.h
+// purpose: F1-style timing at the checkpoints. One slot per (lap % LapWindow,
+//          gate) holds the race time the first car (the leader at that point)
+//          and the most recent car passed it, so at every crossing:
+//            gap to leader    = now - first pass of that slot
+//            interval (ahead) = now - last pass of that slot
+//          Both are one lookup; no history is kept or scanned.
+// used by: ARaceGameState (server), fed from AMyCar::LapCheckpoint.
+// notes: a slot is recycled when a car reaches it on a newer lap. A car more
+//        than LapWindow laps behind the slot's owner gets no reading.
+// ============================================================================
+#include "CoreMinimal.h"
+
+struct ARCDUALDASH_API FRaceIntervalTable
+{
+    void Init(int32 InNumGates, int32 InLapWindow);
+
+    // notes: forget every pass (race restart); keeps the allocation
+    void Reset();
+
+    bool IsValid() const { return NumGates > 0; }
+
+    // notes: records a pass of Gate on Lap at Time (s). Returns false when the
+    //        slot already belongs to a later lap (car lapped beyond the window)
+    bool RecordPass(int32 Lap, int32 Gate, double Time, float& OutGapToLeader, float& OutInterval);
+
+private:
+    struct FSlot
+    {
+        int32 Lap = INDEX_NONE;
+        double FirstTime = 0.0;
+        double LastTime = 0.0;
+    };
+
+    TArray<FSlot> Slots;
+    int32 NumGates = 0;
+    int32 LapWindow = 0;
+};
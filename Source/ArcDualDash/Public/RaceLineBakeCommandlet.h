@@ -0,0 +1,31 @@
+#pragma once
+
+// ============================================================================
+// RaceLineBakeCommandlet.h
+// purpose: bakes URaceLineData (racing line + speed targets) for one or more
+//          race maps.
+// usage:   UnrealEditor-Cmd ArcDualDash.uproject -run=RaceLineBake
+//              [-Map=/Game/TestMinimal[,/Game/Other]]
+//          without -Map the project's default game map is baked.
+// notes: reads the map's baked <MapName>_Track (run RaceTrackBake first, it
+//        holds the gate widths), writes <TrackDataPath>/<MapName>_Line.uasset.
+//        The map itself is not loaded. Returns non-zero if a line could not
+//        be optimised.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RaceLineBakeCommandlet.generated.h"
+
+UCLASS()
+class ARCDUALDASH_API URaceLineBakeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URaceLineBakeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    bool BakeMap(const FString& MapPackageName);
+};
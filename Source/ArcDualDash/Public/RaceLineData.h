@@ -0,0 +1,61 @@
+#pragma once
+
+// ============================================================================
+// RaceLineData.h
+// purpose: baked racing line for one track: a minimum-curvature path inside
+//          the gates plus a target speed per point (lateral grip, accel and
+//          brake limits).
+// why: line geometry is an offline optimisation (thousands of relaxation
+//      passes); at runtime guidance only samples the result.
+// used by: RaceLineBakeCommandlet (bakes it), RaceGameState (loads it),
+//          AMyCar (proxy cars follow it), RaceTrainingSubsystem (observations).
+// notes: one asset per map, named <MapName>_Line under TrackDataPath, built
+//        from the baked <MapName>_Track. No runtime fallback: without the
+//        asset guidance falls back to the centreline.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "RaceTrackLine.h"
+#include "RaceLineData.generated.h"
+
+class URaceTrackData;
+
+struct FRaceLineBakeParams
+{
+    float Spacing = 200.f;          // cm between line points
+    int32 Iterations = 400;         // relaxation passes per resolution level
+    float EdgeMargin = 150.f;       // cm kept clear of each gate edge
+    float MaxSpeed = 4500.f;        // cm/s
+    float LateralAccel = 1500.f;    // cm/s^2
+    float Accel = 800.f;            // cm/s^2
+    float Brake = 1500.f;           // cm/s^2
+
+    static FRaceLineBakeParams FromSettings();
+};
+
+UCLASS(BlueprintType)
+class ARCDUALDASH_API URaceLineData : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Racing Line")
+    FRaceTrackLine Line;
+
+    // notes: cm/s, one per Line point
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Racing Line")
+    TArray<float> TargetSpeeds;
+
+    // notes: lap time of the speed profile, for comparing bakes
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Racing Line")
+    float EstimatedLapTime = 0.f;
+
+    // notes: interpolated between the two line points around Distance; 0 if not baked
+    float GetTargetSpeed(float Distance) const;
+
+    // notes: optimises the line inside Track's gates; returns false (and logs) on an unusable track
+    bool Bake(const URaceTrackData& Track, const FRaceLineBakeParams& Params);
+
+    static FSoftObjectPath GetAssetPathForWorld(const UWorld* World);
+    static FString GetAssetPathForMap(const FString& MapPackageName);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+// ============================================================================
+// RaceLogicSubsystem.h
+// purpose: runs race logic at a fixed rate (RaceLogicHz) from an accumulator,
+//          independent of the render frame rate:
+//            ARaceGameState::FixedRaceTick  race clock
+//            AMyCar::FixedRaceTick          next-gate distance, local timer, HUD events
+//            track limits                   one distance-field lookup per car (server)
+//            URaceAnalyticsSubsystem        car snapshot, leaderboard cadence
+//          GetAlpha() is how far the frame is into the next step, for
+//          interpolating logic outputs on screen.
+// why: at 144 fps the old per-frame Tick did ~5x the logic work of 30 Hz for
+//      no gameplay benefit, and step-based results are reproducible.
+// notes: lap / checkpoint bookkeeping stays event driven (gate overlaps).
+//        Each frame's steps run inside an FMemMark: per-step scratch goes on
+//        FMemStack (TMemStackAllocator), never the heap. Non-shipping builds
+//        count the heap allocations the steps still make (race.MallocCounter).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RaceLogicSubsystem.generated.h"
+
+class AMyCar;
+class ARaceGameState;
+
+UCLASS()
+class ARCDUALDASH_API URaceLogicSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    static URaceLogicSubsystem* Get(const UObject* WorldContext);
+
+    // notes: seconds per logic step (1 / RaceLogicHz)
+    float GetFixedStep() const;
+
+    // notes: [0, 1) fraction of the next step already elapsed this frame
+    float GetAlpha() const { return Alpha; }
+
+    // notes: logic steps run since the world started
+    uint64 GetStepCount() const { return StepCount; }
+
+    // notes: heap allocations made by last frame's steps; 0 unless the counter is installed (RaceMallocCounter)
+    uint32 GetLastTickMallocs() const { return LastTickMallocs; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void Step(float StepSeconds);
+
+    // notes: samples the track's baked distance field for every car (RaceTrackLimits)
+    void UpdateTrackLimits(const ARaceGameState& GS, const TArray<AMyCar*>& Cars, float StepSeconds);
+
+    float Accumulator = 0.f;
+    float Alpha = 0.f;
+    uint64 StepCount = 0;
+    uint32 LastTickMallocs = 0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+// ============================================================================
+// RaceMallocCounter.h
+// purpose: debug heap-allocation counter for the race tick. A pass-through
+//          FMalloc wrapped around GMalloc counts Malloc / Realloc calls made
+//          by a thread while it has an FRaceMallocScope open.
+// why: with several race instances and many cars per process, small per-frame
+//      allocations on the game thread turn into allocator contention; the
+//      steady-state race tick should not touch the heap at all.
+// used by: RaceLogicSubsystem (one scope around each frame's logic steps),
+//          RacePerfTests (SteadyStateMallocs).
+// notes: not compiled into Shipping (RACE_MALLOC_COUNTER). Start with
+//        -RaceMallocCounter to install the wrapper at module startup; it is
+//        never removed, and until it is installed scopes count 0.
+//        A late Install (cvar / test) swaps GMalloc with an atomic exchange
+//        while other threads allocate. Threads that already loaded the old
+//        pointer finish through the wrapped allocator itself, so no block
+//        changes allocator; their calls are simply not counted. Engine code
+//        that cached GMalloc elsewhere is never counted.
+//        Frees are not counted. Platforms that inline their allocator
+//        (PLATFORM_USES_FIXED_GMalloc_CLASS) bypass GMalloc and cannot count.
+// console: race.MallocCounter 0|1|2  (1 = count, 2 = also log frames that allocated)
+// ============================================================================
+#include "CoreMinimal.h"
+
+#define RACE_MALLOC_COUNTER (!UE_BUILD_SHIPPING)
+
+#if RACE_MALLOC_COUNTER
+
+namespace RaceMallocCounter
+{
+    // notes: game thread; false if allocations cannot be counted on this platform
+    ARCDUALDASH_API bool Install();
+    ARCDUALDASH_API bool IsInstalled();
+
+    // notes: race.MallocCounter >= 2
+    ARCDUALDASH_API bool ShouldLogFrames();
+}
+
+// counts this thread's allocations while alive; scopes nest
+class ARCDUALDASH_API FRaceMallocScope
+{
+public:
+    FRaceMallocScope();
+    ~FRaceMallocScope();
+
+    uint32 GetCount() const;
+
+private:
+    uint32 StartCount;
+};
+
+#endif // RACE_MALLOC_COUNTER
@@ -0,0 +1,31 @@
+#pragma once
+
+// ============================================================================
+// RaceMemory.h
+// purpose: Low-Level Memory Tracker tags for the race systems + budget report.
+//            Race/State        game state, track data, startup, streaming
+//            Race/Leaderboard  ranking, fast-array replication
+//            Race/Collectables pickup actors
+//            Race/HUD          per-player widgets, loading overlay
+//            Race/Vehicles     cars, vehicle registry, proximity grid, FX pool
+//            Race/Replay       input recordings / telemetry buffers / results store
+// usage:   LLM_SCOPE_BYTAG(Race_Leaderboard); at the top of a function that
+//          allocates for that system. Run with -llm to collect.
+// console: race.MemReport  -> usage per tag vs URaceSettings budgets
+// ============================================================================
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+LLM_DECLARE_TAG_API(Race, ARCDUALDASH_API);
+LLM_DECLARE_TAG_API(Race_State, ARCDUALDASH_API);
+LLM_DECLARE_TAG_API(Race_Leaderboard, ARCDUALDASH_API);
+LLM_DECLARE_TAG_API(Race_Collectables, ARCDUALDASH_API);
+LLM_DECLARE_TAG_API(Race_HUD, ARCDUALDASH_API);
+LLM_DECLARE_TAG_API(Race_Vehicles, ARCDUALDASH_API);
+LLM_DECLARE_TAG_API(Race_Replay, ARCDUALDASH_API);
+
+namespace RaceMemory
+{
+    // notes: prints every race tag against its budget; returns the number of budgets exceeded
+    ARCDUALDASH_API int32 PrintReport(FOutputDevice& Ar);
+}
@@ -14,6 +14,8 @@
 
 // Forward declarations (for cleaner includes)
 class UWBP_RaceHUD;
+class SRaceMinimap;
+class UGameViewportClient;
 
 /**
  * Per-player controller that handles local HUD spawn and restart hotkey.
@@ -31,9 +33,15 @@ protected:
     virtual void SetupInputComponent() override;
 
 private:
-    /** Spawns and attaches WBP_RaceHUD for this local player */
+    /** Queues HUD creation until the race preload is done */
     void SpawnLocalHUD();
 
+    /** Spawns and attaches WBP_RaceHUD for this local player */
+    void CreateLocalHUD();
+
+    /** Adds the native minimap to this player's split-screen pane */
+    void CreateMinimap(ULocalPlayer* LP, UGameViewportClient* GVC);
+
     /** Reloads the current level (used by F12 hotkey) */
     UFUNCTION()
     void HandleRestartHotkey();
@@ -50,4 +58,8 @@ public:
     /** 1-based index for display / leaderboard (Player 1, Player 2, etc.) */
     UPROPERTY(BlueprintReadOnly, Category = "Player")
     int32 PlayerIndex = 0;
+
+private:
+    /** Slate minimap (owned by the viewport, kept to avoid adding it twice) */
+    TSharedPtr<SRaceMinimap> Minimap;
 };
@@ -0,0 +1,44 @@
+#pragma once
+
+// ============================================================================
+// RacePreloadData.h
+// purpose: primary data asset listing everything a race needs before green
+//          light (car BPs, VehicleVarietyVol2 meshes, HUD widgets, FX).
+// why: soft refs + AssetBundles so the Asset Manager can stream them async
+//      instead of the first reference hitching the game thread.
+// used by: RaceStartupSubsystem (scanned as PrimaryAssetType "RacePreload").
+// notes: no instance ships yet; until one is saved under /Game/Race the
+//        preload stage streams nothing and green light waits only on HUDs.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "RacePreloadData.generated.h"
+
+class AMyCar;
+class UUserWidget;
+class USkeletalMesh;
+
+UCLASS(BlueprintType)
+class ARCDUALDASH_API URacePreloadData : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // notes: car Blueprints that can be spawned in a race (BP_MyCar etc.)
+    UPROPERTY(EditAnywhere, Category = "Preload", meta = (AssetBundles = "Race"))
+    TArray<TSoftClassPtr<AMyCar>> CarClasses;
+
+    // notes: VehicleVarietyVol2 meshes used by the car BPs / liveries
+    UPROPERTY(EditAnywhere, Category = "Preload", meta = (AssetBundles = "Race"))
+    TArray<TSoftObjectPtr<USkeletalMesh>> VehicleMeshes;
+
+    // notes: per-player HUD widgets (WBP_RaceHUD ...)
+    UPROPERTY(EditAnywhere, Category = "Preload", meta = (AssetBundles = "Race"))
+    TArray<TSoftClassPtr<UUserWidget>> HUDWidgets;
+
+    // notes: any FX / sounds touched during the first lap (crash, boost, pickup)
+    UPROPERTY(EditAnywhere, Category = "Preload", meta = (AssetBundles = "Race"))
+    TArray<TSoftObjectPtr<UObject>> Effects;
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+// ============================================================================
+// RaceProximityGrid.h
+// purpose: flat uniform grid (XY) over car positions, rebuilt once per frame
+//          for all cars, answering "who is near this point" from the 3x3
+//          cells around it.
+// why: per-car sweeps / overlaps are O(n^2) in a pack; build + queries here
+//      stay roughly linear as long as the cell size ~ query radius.
+// used by: URaceVehicleSubsystem (slipstream / drafting).
+// notes: indices refer to the positions array passed to Build.
+// ============================================================================
+#include "CoreMinimal.h"
+
+struct ARCDUALDASH_API FRaceProximityGrid
+{
+    // notes: CellSize should be >= the largest query radius (3x3 lookup)
+    void Build(TConstArrayView<FVector> Positions, float InCellSize);
+
+    // notes: calls Visit(Index) for every entry in the 3x3 cells around Location (caller filters by distance)
+    template <typename FuncType>
+    void ForEachNearby(const FVector& Location, FuncType&& Visit) const
+    {
+        const FIntPoint Center = ToCell(Location);
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                const FIntPoint* Range = CellRanges.Find(FIntPoint(Center.X + DX, Center.Y + DY));
+                if (!Range)
+                {
+                    continue;
+                }
+                for (int32 i = Range->X; i < Range->X + Range->Y; ++i)
+                {
+                    Visit(SortedIndices[i]);
+                }
+            }
+        }
+    }
+
+    int32 Num() const { return SortedIndices.Num(); }
+
+private:
+    FIntPoint ToCell(const FVector& Location) const
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+    }
+
+    float InvCellSize = 1.f / 2500.f;
+
+    // notes: entries grouped by cell; CellRanges maps cell -> (start, count) into SortedIndices
+    TArray<int32> SortedIndices;
+    TArray<FIntPoint> EntryCells;
+    TMap<FIntPoint, FIntPoint> CellRanges;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+// ============================================================================
+// RaceReplaySubsystem.h
+// purpose: deterministic input record / replay for reproducible perf captures.
+//            -RaceRecord=<file>   record the drive input of every local player
+//                                 car (P1 + P2 proxy), frame by frame
+//            -RaceReplay=<file>   feed the stream back; live input is ignored
+//          Both run on a fixed frame rate (ReplayFrameRate) with the global RNG
+//          seeded from the file, so a replay repeats the same race workload.
+//          Add -RaceReplayUnpaced to replay as fast as possible.
+// file:    Saved/Replays/<file>.rrec unless a path is given. Header (seed, dt,
+//          map) + one record per frame in which some car's input changed.
+// notes:   one recording per map load; it is flushed on map change / exit.
+//          Physics is replayed, not snapshotted, so long runs can drift by
+//          solver noise; inputs and timing are bit-identical.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "MyCar.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RaceReplaySubsystem.generated.h"
+
+// one local car's input from a given frame on
+struct FRaceReplayEvent
+{
+    uint32 Frame = 0;
+    uint8 Slot = 0;     // local player controller id
+    FRaceDriveInput Input;
+
+    friend FArchive& operator<<(FArchive& Ar, FRaceReplayEvent& Event);
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceReplaySubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static URaceReplaySubsystem* Get(const UObject* WorldContext);
+
+    // notes: true while a replay owns the cars; player input handlers bail out
+    static bool IsReplaying(const UObject* WorldContext);
+
+    // notes: only exists with -RaceRecord= or -RaceReplay= on the command line
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+private:
+    enum class EMode : uint8 { Record, Replay };
+
+    void HandlePreLoadMap(const FString& MapName);
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+    void HandleBeginFrame();
+    void HandleEndFrame();
+
+    void ApplyTimeStep() const;
+    AMyCar* GetLocalCar(int32 Slot) const;
+
+    void CaptureFrame();
+    void PlayFrame();
+
+    bool SaveRecording();
+    bool LoadRecording();
+
+    static FString ResolvePath(const FString& Name);
+
+    EMode Mode = EMode::Record;
+    FString FilePath;
+    FString MapName;
+    int32 Seed = 0;
+    float FixedDeltaTime = 0.f;
+    bool bUnpaced = false;
+    bool bActive = false;
+
+    // --- stream ---
+    TArray<FRaceReplayEvent> Events;
+    int32 Cursor = 0;
+    uint32 Frame = 0;
+    uint32 NumRecordedFrames = 0;
+
+    // notes: last input written per slot; only changes are recorded
+    static constexpr int32 MaxSlots = 4;
+    FRaceDriveInput LastInput[MaxSlots];
+    bool bHasLastInput[MaxSlots] = {};
+
+    FDelegateHandle PreLoadMapHandle;
+    FDelegateHandle PostLoadMapHandle;
+    FDelegateHandle BeginFrameHandle;
+    FDelegateHandle EndFrameHandle;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+// ============================================================================
+// RaceResultsSubsystem.h
+// purpose: local best-times store that survives level reloads. Per track:
+//            <Track>.rres  append-only fixed-size result records (history)
+//            <Track>.ridx  index: top-N race times + personal best per
+//                          (player, car), with the record count it covers
+//          Queries (top-N, personal best) are answered from the index; the
+//          history is never loaded as a whole.
+// why: kiosks keep thousands of results per track; load and save must not
+//      hitch the game thread.
+// notes: every file access runs on one worker pipe (ordered, off the game
+//        thread). The index is loaded when a track map loads; if it covers
+//        fewer records than the history holds (crash between the two writes)
+//        only the missing tail is scanned. Queries before the load finished
+//        return nothing.
+// file:  Saved/RaceResults/ (URaceSettings::ResultsDirectory)
+// console: race.Results [N]
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Pipe.h"
+#include <atomic>
+#include "RaceResultsSubsystem.generated.h"
+
+class AMyCar;
+
+// one finished race of one car; fixed size so the history is seekable
+struct FRaceResultRecord
+{
+    int64 UnixTime = 0;
+    float RaceTime = 0.f;
+    float BestLapTime = 0.f;
+    uint16 Laps = 0;
+    uint8 Position = 0;
+    uint8 NumCars = 0;
+    uint8 bAI = 0;
+    uint8 Pad[3] = {};
+    ANSICHAR PlayerName[32] = {};
+    ANSICHAR CarName[32] = {};
+};
+static_assert(sizeof(FRaceResultRecord) == 96, "FRaceResultRecord is a file format");
+
+USTRUCT(BlueprintType)
+struct FRaceResultEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Results")
+    FString PlayerName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Results")
+    FString CarName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Results")
+    float RaceTime = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Results")
+    float BestLapTime = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Race|Results")
+    FDateTime Date;
+
+    // notes: position of the record in <Track>.rres
+    int64 RecordIndex = INDEX_NONE;
+
+    friend FArchive& operator<<(FArchive& Ar, FRaceResultEntry& Entry);
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceResultsSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static URaceResultsSubsystem* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // notes: server; called once when Car crosses the line after its last lap
+    void SubmitFinish(const AMyCar& Car, float RaceTime, int32 Position, int32 NumCars);
+
+    // notes: false while the track's index is still loading
+    UFUNCTION(BlueprintCallable, Category = "Race|Results")
+    bool GetTopResults(const FString& Track, int32 Count, TArray<FRaceResultEntry>& OutResults) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Race|Results")
+    bool GetPersonalBest(const FString& Track, const FString& PlayerName, const FString& CarName, FRaceResultEntry& OutResult) const;
+
+    // notes: track key of a world (map name without path / PIE prefix)
+    static FString GetTrackName(const UWorld* World);
+
+    void PrintTopResults(const FString& Track, int32 Count) const;
+
+private:
+    struct FTrackIndex
+    {
+        int64 NumRecords = 0;
+        TArray<FRaceResultEntry> Top;                   // RaceTime ascending, <= ResultsTopN
+        TMap<FString, FRaceResultEntry> PersonalBests;  // "player|car"
+
+        void Add(const FRaceResultRecord& Record, int64 RecordIndex, int32 MaxTop);
+
+        friend FArchive& operator<<(FArchive& Ar, FTrackIndex& Index)
+        {
+            return Ar << Index.NumRecords << Index.Top << Index.PersonalBests;
+        }
+    };
+
+    struct FTrackStore
+    {
+        FString Track;
+        FString DataPath;
+        FString IndexPath;
+
+        // notes: written on the pipe, read by queries on the game thread
+        mutable FCriticalSection Lock;
+        FTrackIndex Index;
+        std::atomic<bool> bLoaded{ false };
+    };
+
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+    TSharedRef<FTrackStore> FindOrLoadTrack(const FString& Track);
+    TSharedPtr<const FTrackStore> FindLoadedTrack(const FString& Track) const;
+
+    // --- pipe (worker) side ---
+    static void LoadIndex(FTrackStore& Store, int32 MaxTop);
+    static void AppendRecord(FTrackStore& Store, const FRaceResultRecord& Record, int32 MaxTop);
+    static bool SaveIndex(const FTrackStore& Store);
+
+    static FString MakeKey(const FString& PlayerName, const FString& CarName) { return PlayerName + TEXT("|") + CarName; }
+
+    TMap<FString, TSharedRef<FTrackStore>> Tracks;
+    UE::Tasks::FPipe IOPipe{ UE_SOURCE_LOCATION };
+
+    FDelegateHandle PostLoadMapHandle;
+};
@@ -0,0 +1,380 @@
+#pragma once
+
+// ============================================================================
+// RaceSettings.h
+// purpose: project-wide race tuning (Project Settings -> Game -> Race).
+// why: keeps budgets / pool sizes / rates in DefaultGame.ini instead of
+//      hard-coding them in actors.
+// used by: RaceStartupSubsystem (startup budget, preload bundles),
+//          RaceTrackData / RaceTrackBakeCommandlet (track bake),
+//          RaceLineData / RaceLineBakeCommandlet (racing line bake),
+//          RaceVehicleSubsystem (vehicle sim LOD),
+//          RaceSignificanceSubsystem (anim / tick / shadow / FX throttling),
+//          RaceFXPoolSubsystem (pooled Niagara effects),
+//          RaceStreamingSubsystem (World Partition streaming sources),
+//          RaceVehicleSubsystem (slipstream detection),
+//          RaceMemory (LLM budgets),
+//          RaceLogicSubsystem (fixed race logic rate),
+//          RaceInstanceSubsystem (headless multi-race host),
+//          RaceTrainingSubsystem (shared-memory step API),
+//          RaceReplaySubsystem (input record / replay),
+//          RaceEventBus (event ring size),
+//          RaceGameState (checkpoint interval table),
+//          SRaceMinimap (per-player minimap),
+//          RaceResultsSubsystem (best-times store),
+//          RaceGameState / Collectable (GC-quiet race),
+//          RaceTrackLimits / RaceLogicSubsystem (track limits).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "RaceSettings.generated.h"
+
+class UNiagaraSystem;
+
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Race"))
+class ARCDUALDASH_API URaceSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    URaceSettings();
+
+    static const URaceSettings* Get() { return GetDefault<URaceSettings>(); }
+
+    // --- Startup / preload ---
+
+    // notes: primary asset type scanned by the Asset Manager for race preload data
+    UPROPERTY(config, EditAnywhere, Category = "Startup")
+    FName PreloadAssetType = TEXT("RacePreload");
+
+    // notes: bundles requested from every preload asset (see URacePreloadData)
+    UPROPERTY(config, EditAnywhere, Category = "Startup")
+    TArray<FName> PreloadBundles;
+
+    // notes: cold start (process start -> green light) budget in seconds; report warns above it
+    UPROPERTY(config, EditAnywhere, Category = "Startup", meta = (ClampMin = "1.0"))
+    float StartupBudgetSeconds = 20.f;
+
+    // notes: show the loading overlay while the preload is in flight
+    UPROPERTY(config, EditAnywhere, Category = "Startup")
+    bool bShowLoadingScreen = true;
+
+    // --- Track data (baked by the RaceTrackBake commandlet) ---
+
+    // notes: folder holding <MapName>_Track assets
+    UPROPERTY(config, EditAnywhere, Category = "Track", meta = (ContentDir))
+    FString TrackDataPath = TEXT("/Game/Race/Tracks");
+
+    UPROPERTY(config, EditAnywhere, Category = "Track", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 RespawnSlotsPerGate = 4;
+
+    // notes: lateral spacing between respawn slots at a gate (cm)
+    UPROPERTY(config, EditAnywhere, Category = "Track", meta = (ClampMin = "0"))
+    float RespawnLaneSpacing = 220.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Track", meta = (ClampMin = "1"))
+    int32 NumSectors = 3;
+
+    // --- Track limits (distance field baked with the track, see RaceTrackLimits) ---
+
+    // notes: bake the field and check every car each logic step (server)
+    UPROPERTY(config, EditAnywhere, Category = "Track Limits")
+    bool bTrackLimits = true;
+
+    // notes: grid spacing of the baked field (cm); grows automatically on very large tracks
+    UPROPERTY(config, EditAnywhere, Category = "Track Limits", meta = (ClampMin = "10"))
+    float TrackLimitsCellSize = 200.f;
+
+    // notes: how far the car's origin may be past the edge before it counts as off track (kerbs, cm)
+    UPROPERTY(config, EditAnywhere, Category = "Track Limits", meta = (ClampMin = "0"))
+    float TrackLimitsTolerance = 100.f;
+
+    // notes: a cut is lap distance gained off track beyond the distance driven there (cm)
+    UPROPERTY(config, EditAnywhere, Category = "Track Limits", meta = (ClampMin = "0"))
+    float TrackLimitsCutTolerance = 1000.f;
+
+    // notes: put cars that stay off track back at their last gate (AMyCar::RespawnCar)
+    UPROPERTY(config, EditAnywhere, Category = "Track Limits")
+    bool bTrackLimitsAutoRespawn = false;
+
+    UPROPERTY(config, EditAnywhere, Category = "Track Limits", meta = (ClampMin = "0", EditCondition = "bTrackLimitsAutoRespawn"))
+    float TrackLimitsRespawnSeconds = 3.f;
+
+    // --- Racing line (baked by the RaceLineBake commandlet, see RaceLineData) ---
+
+    // notes: distance between racing line points (cm)
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "10"))
+    float RacingLineSpacing = 200.f;
+
+    // notes: relaxation passes per resolution level
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "1"))
+    int32 RacingLineIterations = 400;
+
+    // notes: distance the line keeps from the gate edges (about half a car width, cm)
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "0"))
+    float RacingLineEdgeMargin = 150.f;
+
+    // notes: speed profile limits (cm/s, cm/s^2)
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "100"))
+    float RacingLineMaxSpeed = 4500.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "1"))
+    float RacingLineLateralAccel = 1500.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "1"))
+    float RacingLineAccel = 800.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Racing Line", meta = (ClampMin = "1"))
+    float RacingLineBrake = 1500.f;
+
+    // --- Race logic (fixed-rate, see RaceLogicSubsystem) ---
+
+    // notes: timer / leaderboard / next-gate distances / HUD events run at this rate
+    UPROPERTY(config, EditAnywhere, Category = "Race Logic", meta = (ClampMin = "5", ClampMax = "240"))
+    float RaceLogicHz = 30.f;
+
+    // notes: catch-up cap after a hitch; remaining time is dropped instead of spiralling
+    UPROPERTY(config, EditAnywhere, Category = "Race Logic", meta = (ClampMin = "1"))
+    int32 MaxRaceLogicStepsPerFrame = 4;
+
+    // notes: leaderboard re-rank period (s), rounded to whole logic steps
+    UPROPERTY(config, EditAnywhere, Category = "Race Logic", meta = (ClampMin = "0.0"))
+    float LeaderboardInterval = 0.5f;
+
+    // notes: laps of checkpoint pass times kept for gaps / intervals; a car further
+    //        behind the leader than this gets no gap reading
+    UPROPERTY(config, EditAnywhere, Category = "Race Logic", meta = (ClampMin = "1"))
+    int32 IntervalLapWindow = 4;
+
+    // --- Headless race instances (-RaceInstances=K, see RaceInstanceSubsystem) ---
+
+    // notes: cars spawned per instance; -RaceInstanceCars=N overrides
+    UPROPERTY(config, EditAnywhere, Category = "Instances", meta = (ClampMin = "1"))
+    int32 InstanceCarsPerRace = 8;
+
+    // notes: wall-clock seconds before an unfinished instance is recorded as timed out
+    UPROPERTY(config, EditAnywhere, Category = "Instances", meta = (ClampMin = "0.0"))
+    float InstanceTimeoutSeconds = 900.f;
+
+    // notes: quit the process once results are written (batch evaluation)
+    UPROPERTY(config, EditAnywhere, Category = "Instances")
+    bool bExitWhenInstancesFinish = true;
+
+    // --- Training step API (-RaceTraining=<region>, see RaceTrainingSubsystem) ---
+
+    // notes: action / observation slots in the shared region; -RaceTrainingCars=N overrides
+    UPROPERTY(config, EditAnywhere, Category = "Training", meta = (ClampMin = "1", ClampMax = "1024"))
+    int32 TrainingMaxCars = 16;
+
+    // notes: give up and quit if the trainer posts no actions for this long (s)
+    UPROPERTY(config, EditAnywhere, Category = "Training", meta = (ClampMin = "1.0"))
+    float TrainingWaitTimeoutSeconds = 60.f;
+
+    // --- Input record / replay (-RaceRecord=<file>, -RaceReplay=<file>, see RaceReplaySubsystem) ---
+
+    // notes: fixed frame rate used while recording and replaying, so frames line up 1:1
+    UPROPERTY(config, EditAnywhere, Category = "Replay", meta = (ClampMin = "10", ClampMax = "240"))
+    float ReplayFrameRate = 60.f;
+
+    // notes: quit once the recorded stream runs out (scripted perf captures)
+    UPROPERTY(config, EditAnywhere, Category = "Replay")
+    bool bQuitAfterReplay = true;
+
+    // --- Event bus (see RaceEventBus) ---
+
+    // notes: ring slots between producers and the per-frame drain (rounded up to a power of two)
+    UPROPERTY(config, EditAnywhere, Category = "Events", meta = (ClampMin = "64"))
+    int32 EventBusCapacity = 4096;
+
+    // --- Minimap (native Slate, one per local player, see SRaceMinimap) ---
+
+    UPROPERTY(config, EditAnywhere, Category = "Minimap")
+    bool bShowMinimap = true;
+
+    // notes: widget edge length in slate units (square)
+    UPROPERTY(config, EditAnywhere, Category = "Minimap", meta = (ClampMin = "64"))
+    float MinimapSize = 220.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Minimap", meta = (ClampMin = "2"))
+    float MinimapMarkerSize = 8.f;
+
+    // --- Results store (see RaceResultsSubsystem) ---
+
+    // notes: off for kiosk demo rounds that should not enter the table
+    UPROPERTY(config, EditAnywhere, Category = "Results")
+    bool bRecordResults = true;
+
+    // notes: entries kept in the index's top list per track
+    UPROPERTY(config, EditAnywhere, Category = "Results", meta = (ClampMin = "1"))
+    int32 ResultsTopN = 10;
+
+    // notes: relative to Saved/
+    UPROPERTY(config, EditAnywhere, Category = "Results")
+    FString ResultsDirectory = TEXT("RaceResults");
+
+    // --- Garbage collection (GC-quiet race, see ARaceGameState::BeginQuietRace) ---
+
+    // notes: no UObject churn between green light and podium: pickups are hidden instead of
+    //        destroyed, automatic GC is pushed past the race and runs at the podium
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection")
+    bool bGCQuietRace = true;
+
+    // notes: longest a race may defer GC; memory pressure / level streaming still collect
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection", meta = (ClampMin = "0"))
+    float QuietRaceMaxSeconds = 900.f;
+
+    // --- Vehicle simulation LOD (distances to the nearest local viewpoint, cm) ---
+
+    // notes: full Chaos sim + anim inside this range
+    UPROPERTY(config, EditAnywhere, Category = "Vehicle LOD", meta = (ClampMin = "0"))
+    float FullSimDistance = 6000.f;
+
+    // notes: beyond this AI cars become kinematic proxies moved along the track line
+    UPROPERTY(config, EditAnywhere, Category = "Vehicle LOD", meta = (ClampMin = "0"))
+    float ProxySimDistance = 20000.f;
+
+    // notes: fraction of a threshold used as dead band so cars don't flap between tiers
+    UPROPERTY(config, EditAnywhere, Category = "Vehicle LOD", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+    float LODHysteresis = 0.1f;
+
+    // notes: how often tiers are re-evaluated (seconds)
+    UPROPERTY(config, EditAnywhere, Category = "Vehicle LOD", meta = (ClampMin = "0.0"))
+    float LODUpdateInterval = 0.25f;
+
+    // notes: actor + vehicle component tick interval used by the Reduced tier. Tick only:
+    //        Chaos still simulates suspension / wheels every physics step (Proxy is the sim cut)
+    UPROPERTY(config, EditAnywhere, Category = "Vehicle LOD", meta = (ClampMin = "0.0"))
+    float ReducedTickInterval = 1.f / 30.f;
+
+    // --- Significance (best screen-size fraction over all local viewports) ---
+
+    // notes: at or above -> High (full rate, shadows)
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float HighScreenSize = 0.12f;
+
+    // notes: at or above -> Medium, below -> Low; not in any view frustum -> Hidden
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float MediumScreenSize = 0.03f;
+
+    // notes: how often scores are recomputed (seconds)
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float SignificanceUpdateInterval = 0.1f;
+
+    // notes: tick / anim interval per bucket (High is always every frame)
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float MediumTickInterval = 1.f / 30.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float LowTickInterval = 1.f / 10.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float HiddenTickInterval = 0.5f;
+
+    // notes: Niagara user float the pooled systems multiply their spawn rate by (High = 1)
+    UPROPERTY(config, EditAnywhere, Category = "Significance")
+    FName FXSpawnScaleParameter = TEXT("SpawnScale");
+
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float MediumFXSpawnScale = 0.5f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float LowFXSpawnScale = 0.25f;
+
+    // --- FX pool (pre-warmed at race start, reused round-robin) ---
+
+    // notes: unset -> no explosion pool, cars fall back to their Cascade AMyCar::ExplosionFX
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool")
+    TSoftObjectPtr<UNiagaraSystem> ExplosionFX;
+
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool")
+    TSoftObjectPtr<UNiagaraSystem> BoostTrailFX;
+
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool")
+    TSoftObjectPtr<UNiagaraSystem> PickupFX;
+
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool", meta = (ClampMin = "1"))
+    int32 ExplosionPoolSize = 6;
+
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool", meta = (ClampMin = "1"))
+    int32 BoostTrailPoolSize = 8;
+
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool", meta = (ClampMin = "1"))
+    int32 PickupPoolSize = 8;
+
+    // notes: spawns beyond this in one frame are dropped (pile-ups)
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool", meta = (ClampMin = "1"))
+    int32 MaxFXSpawnsPerFrame = 3;
+
+    // notes: one-shot FX farther than this from every local viewport are not played (cm)
+    UPROPERTY(config, EditAnywhere, Category = "FX Pool", meta = (ClampMin = "0"))
+    float FXCullDistance = 15000.f;
+
+    // --- World Partition streaming (track-progress driven, see RaceStreamingSubsystem) ---
+
+    // notes: replace the local player controllers' camera streaming sources
+    UPROPERTY(config, EditAnywhere, Category = "Streaming")
+    bool bPredictiveStreaming = true;
+
+    // notes: look ahead this many seconds at the car's current speed
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "0.0"))
+    float StreamingLookaheadSeconds = 4.f;
+
+    // notes: minimum look-ahead along the track (cm), used while slow / on the grid
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "0"))
+    float StreamingMinLookahead = 8000.f;
+
+    // notes: kept behind each player (cm); anything behind last place is released
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "0"))
+    float StreamingBehindDistance = 3000.f;
+
+    // notes: spacing between sources along the track (cm)
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "500"))
+    float StreamingSampleSpacing = 6000.f;
+
+    // notes: radius of each source (cm); 0 = use the runtime grid's loading range
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "0"))
+    float StreamingSourceRadius = 10000.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "1", ClampMax = "32"))
+    int32 MaxStreamingSourcesPerPlayer = 8;
+
+    UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "0.0"))
+    float StreamingUpdateInterval = 0.2f;
+
+    // --- Slipstream / drafting (detection; per-car strength lives on AMyCar) ---
+
+    UPROPERTY(config, EditAnywhere, Category = "Slipstream")
+    bool bEnableSlipstream = true;
+
+    // notes: max gap to the car ahead (cm); also the proximity grid cell size
+    UPROPERTY(config, EditAnywhere, Category = "Slipstream", meta = (ClampMin = "100"))
+    float SlipstreamRange = 2500.f;
+
+    // notes: half-angle of the cone behind the leader, measured from the follower's heading
+    UPROPERTY(config, EditAnywhere, Category = "Slipstream", meta = (ClampMin = "1.0", ClampMax = "90.0"))
+    float SlipstreamConeHalfAngle = 12.f;
+
+    // notes: no draft below this speed (cm/s), e.g. on the grid
+    UPROPERTY(config, EditAnywhere, Category = "Slipstream", meta = (ClampMin = "0"))
+    float SlipstreamMinSpeed = 1500.f;
+
+    // --- Memory budgets per LLM tag (MB, 0 = no budget), see race.MemReport ---
+
+    UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = "0"))
+    float RaceStateBudgetMB = 8.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = "0"))
+    float LeaderboardBudgetMB = 1.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = "0"))
+    float CollectablesBudgetMB = 4.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = "0"))
+    float HUDBudgetMB = 16.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = "0"))
+    float VehiclesBudgetMB = 64.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = "0"))
+    float ReplayBudgetMB = 16.f;
+};
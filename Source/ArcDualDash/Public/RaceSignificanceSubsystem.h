@@ -0,0 +1,86 @@
+#pragma once
+
+// ============================================================================
+// RaceSignificanceSubsystem.h
+// purpose: split-screen aware significance. Every car / collectable / FX
+//          emitter is scored by projected screen size in EACH local viewport
+//          and keeps the best score, then bucketed:
+//            High   -> full anim + tick, shadows
+//            Medium -> throttled anim / tick, shadows
+//            Low    -> slower anim / tick, no shadows
+//            Hidden -> outside every view frustum: minimal tick, no FX spawns
+//          Pooled FX emitters get a spawn-rate scale per bucket; hidden
+//          trails are paused and hidden one-shots are let die out.
+// why: engine heuristics assume one view; with two they either over-render
+//      (max of both) or pop (only the primary view counts).
+// used by: AMyCar / ACollectable (register + ApplySignificance),
+//          crash FX spawn (ShouldSpawnFX), SRaceMinimap (collectable markers).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RaceVehicleSubsystem.h"
+#include "RaceSignificanceSubsystem.generated.h"
+
+class AMyCar;
+class ACollectable;
+class UFXSystemComponent;
+
+UENUM(BlueprintType)
+enum class ERaceSignificance : uint8
+{
+    High,
+    Medium,
+    Low,
+    Hidden
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void RegisterCollectable(ACollectable* Collectable);
+    void UnregisterCollectable(ACollectable* Collectable);
+
+    const TArray<ACollectable*>& GetCollectables() const { return Collectables; }
+
+    void RegisterEmitter(UFXSystemComponent* Emitter);
+    void UnregisterEmitter(UFXSystemComponent* Emitter);
+
+    // notes: best screen-size fraction of a sphere over all local views (0 = in no frustum)
+    static float ScoreSphere(const FRaceViewpointArray& Viewpoints, const FVector& Center, float Radius);
+
+    // notes: bucket for a score, using URaceSettings thresholds
+    static ERaceSignificance Classify(float Score);
+
+    // notes: one-shot FX gate: false when the spawn point is tiny / off-screen in every view
+    bool ShouldSpawnFX(const FVector& Location, float Radius = 300.f) const;
+
+    // notes: tick / anim interval for a bucket (High = every frame)
+    static float GetTickIntervalFor(ERaceSignificance Significance);
+
+    // notes: value for URaceSettings::FXSpawnScaleParameter in a bucket (High = 1, Hidden = 0)
+    static float GetFXSpawnScaleFor(ERaceSignificance Significance);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void UpdateSignificance();
+    static void ApplyEmitterSignificance(UFXSystemComponent* Emitter, ERaceSignificance Significance);
+
+    UPROPERTY()
+    TArray<ACollectable*> Collectables;
+
+    UPROPERTY()
+    TArray<UFXSystemComponent*> Emitters;
+
+    // notes: cached once per update so ShouldSpawnFX is cheap between updates
+    FRaceViewpointArray CachedViewpoints;
+
+    float TimeSinceUpdate = 0.f;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+// ============================================================================
+// RaceStartupSubsystem.h
+// purpose: race preload stage + time-to-first-race-frame report.
+//          - async loads every RacePreload primary asset (bundles from
+//            URaceSettings) behind a loading overlay
+//          - records map load / actor BeginPlay / local players / preload / HUD
+//          - fires OnGreenLight once preload + HUDs are done
+// used by: RaceGameMode (phases, preload kick), RacePlayerController (HUD,
+//          preload kick on network clients).
+// console: race.StartupReport
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RaceStartupSubsystem.generated.h"
+
+struct FStreamableHandle;
+class SWidget;
+
+UENUM()
+enum class ERaceStartupPhase : uint8
+{
+    MapLoad,
+    ActorBeginPlay,
+    LocalPlayers,
+    AssetPreload,
+    HUD,
+    MAX UMETA(Hidden)
+};
+
+UCLASS()
+class ARCDUALDASH_API URaceStartupSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static URaceStartupSubsystem* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // --- phase timing ---
+    void BeginPhase(ERaceStartupPhase Phase);
+    void EndPhase(ERaceStartupPhase Phase);
+
+    // notes: kicks the async preload for this world; safe to call once per map
+    void BeginRacePreload(UWorld* World);
+
+    // notes: HUD owners report in; green light waits for every local player
+    void NotifyHUDCreated(const ULocalPlayer* LocalPlayer);
+
+    bool IsRaceReady() const { return bPreloadDone; }
+
+    // notes: runs Callback next tick after preload finished (immediately queued if already done)
+    void CallWhenRaceReady(FSimpleDelegate Callback);
+
+    FSimpleMulticastDelegate OnGreenLight;
+
+    void PrintStartupReport() const;
+
+private:
+    struct FPhaseTiming
+    {
+        double Start = 0.0;
+        double End = 0.0;
+    };
+
+    void HandlePreLoadMap(const FString& MapName);
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+    void HandlePreloadComplete();
+    void FlushReadyCallbacks();
+    void CheckGreenLight();
+
+    void ShowLoadingScreen(UWorld* World);
+    void HideLoadingScreen();
+
+    FPhaseTiming Phases[(int32)ERaceStartupPhase::MAX];
+
+    TSharedPtr<FStreamableHandle> PreloadHandle;
+    TArray<FSimpleDelegate> PendingReadyCallbacks;
+    TSet<const ULocalPlayer*> PlayersWithHUD;
+    TSharedPtr<SWidget> LoadingWidget;
+    TWeakObjectPtr<UWorld> PreloadWorld;
+
+    FString CurrentMapName;
+    int32 NumPreloadAssets = 0;
+    double GreenLightTime = 0.0;
+    bool bPreloadDone = false;
+    bool bGreenLight = false;
+    bool bIsColdStart = true;
+
+    FDelegateHandle PreLoadMapHandle;
+    FDelegateHandle PostLoadMapHandle;
+    IConsoleObject* ReportCommand = nullptr;
+};
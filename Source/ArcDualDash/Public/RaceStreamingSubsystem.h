@@ -0,0 +1,57 @@
+#pragma once
+
+// ============================================================================
+// RaceStreamingSubsystem.h
+// purpose: World Partition streaming source provider driven by track progress.
+//          For each local player's car: a source at the car, sources ahead
+//          along the track line out to max(MinLookahead, speed * horizon) and
+//          a short margin behind. Nothing is requested behind the last-placed
+//          local player, so those cells unload.
+// why: camera-radius streaming either loads too late at race speed (pop-in,
+//      hitches) or loads the whole neighbourhood (memory).
+// used by: ARacePlayerController (turns its own streaming source off).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "RaceStreamingSubsystem.generated.h"
+
+class AMyCar;
+
+UCLASS()
+class ARCDUALDASH_API URaceStreamingSubsystem : public UTickableWorldSubsystem, public IWorldPartitionStreamingSourceProvider
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // --- IWorldPartitionStreamingSourceProvider ---
+    virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+    virtual const UObject* GetStreamingSourceOwner() const override { return this; }
+
+    // notes: true once registered with World Partition; player controllers then drop their own source
+    bool IsProvidingStreaming() const { return bRegistered; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void RebuildSources();
+
+    // notes: per local player track tracking (segment hint keeps ProjectNear cheap)
+    struct FTrackedPlayer
+    {
+        TWeakObjectPtr<AMyCar> Car;
+        int32 Segment = 0;
+    };
+
+    TArray<FTrackedPlayer, TInlineAllocator<4>> Players;
+    TArray<FWorldPartitionStreamingSource> Sources;
+
+    bool bRegistered = false;
+    float TimeSinceUpdate = 0.f;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+// ============================================================================
+// RaceTrackBakeCommandlet.h
+// purpose: bakes URaceTrackData for one or more race maps.
+// usage:   UnrealEditor-Cmd ArcDualDash.uproject -run=RaceTrackBake
+//              [-Map=/Game/TestMinimal[,/Game/Other]]
+//          without -Map the project's default game map is baked.
+// notes: loads every ACheckpoints in the map (World Partition actors too),
+//        writes <TrackDataPath>/<MapName>_Track.uasset (gates, respawn slots,
+//        sectors, track-limits field). Returns non-zero if a layout is broken
+//        (duplicate numbers, no start/finish gate).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RaceTrackBakeCommandlet.generated.h"
+
+UCLASS()
+class ARCDUALDASH_API URaceTrackBakeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URaceTrackBakeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    bool BakeMap(const FString& MapPackageName);
+};
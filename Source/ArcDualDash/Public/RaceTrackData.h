@@ -0,0 +1,106 @@
+#pragma once
+
+// ============================================================================
+// RaceTrackData.h
+// purpose: everything about a track layout that does not change at runtime:
+//          ordered checkpoint gates, the centreline + cumulative lengths,
+//          respawn slots per gate, sector boundaries and the track-limits
+//          distance field.
+// why: baked once in the editor (URaceTrackBakeCommandlet) so opening a level
+//      no longer rediscovers / sorts / validates checkpoints.
+// used by: RaceGameState (loads it, falls back to a transient bake),
+//          AMyCar (next-gate distance, respawn slots),
+//          RaceLogicSubsystem (track limits),
+//          RaceLineBakeCommandlet (gates + widths in, racing line out).
+// notes: one asset per map, named <MapName>_Track under TrackDataPath.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "RaceTrackLimits.h"
+#include "RaceTrackLine.h"
+#include "RaceTrackData.generated.h"
+
+class ACheckpoints;
+
+USTRUCT(BlueprintType)
+struct FRaceTrackGate
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    int32 CheckPointNo = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    bool bStartFinishLine = false;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    FVector Location = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    FRotator Rotation = FRotator::ZeroRotator;
+
+    // notes: distance of the gate along TrackLine
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    float Distance = 0.f;
+
+    // notes: scaled box extent across the gate (local Y), i.e. half the drivable width
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    float HalfWidth = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct FRaceTrackSector
+{
+    GENERATED_BODY()
+
+    // notes: index into Gates where the sector starts
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    int32 FirstGate = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    float StartDistance = 0.f;
+};
+
+UCLASS(BlueprintType)
+class ARCDUALDASH_API URaceTrackData : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // notes: sorted by CheckPointNo
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    TArray<FRaceTrackGate> Gates;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    FRaceTrackLine TrackLine;
+
+    // notes: SlotsPerGate consecutive entries per gate (lane order left -> right)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    TArray<FTransform> RespawnSlots;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    int32 SlotsPerGate = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    TArray<FRaceTrackSector> Sectors;
+
+    // notes: baked by the commandlet after Bake (needs the gate widths); invalid on the runtime fallback
+    UPROPERTY(VisibleAnywhere, Category = "Track")
+    FRaceTrackLimits TrackLimits;
+
+    // notes: -1 if no gate has this number
+    int32 FindGateIndex(int32 CheckPointNo) const;
+
+    // notes: Slot is wrapped into [0, SlotsPerGate)
+    bool GetRespawnSlot(int32 GateIndex, int32 Slot, FTransform& OutTransform) const;
+
+    // notes: fills this asset from gates in any order; returns false (and logs) on a broken layout
+    bool Bake(TArray<FRaceTrackGate> InGates, int32 InSlotsPerGate, float LaneSpacing, int32 NumSectors);
+
+    // notes: gate as placed in the level (Distance filled by Bake)
+    static FRaceTrackGate MakeGate(const ACheckpoints& Checkpoint);
+
+    // notes: soft path of the baked asset for World (PIE prefix stripped)
+    static FSoftObjectPath GetAssetPathForWorld(const UWorld* World);
+    static FString GetAssetPathForMap(const FString& MapPackageName);
+};
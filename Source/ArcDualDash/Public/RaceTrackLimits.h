@@ -0,0 +1,58 @@
+#pragma once
+
+// ============================================================================
+// RaceTrackLimits.h
+// purpose: 2D signed-distance field of a track's drivable area, baked into a
+//          regular grid: < 0 inside the track, > 0 outside (cm to the edge).
+//          A car's track-limit check is one bilinear lookup.
+// why: no line traces / overlaps per car; the cost does not depend on the
+//      physics scene, so the whole field is checked every logic step.
+// used by: RaceTrackData (owns it), RaceTrackBakeCommandlet (bakes it),
+//          RaceLogicSubsystem (samples every car), AMyCar (off-track / cut state).
+// notes: the drivable area follows a smooth curve through the gate centres,
+//        sampled at about a track width, each gate as wide as its volume
+//        (FRaceTrackGate::HalfWidth). Bends need enough gates to be shaped
+//        right; the bake warns about long gaps. Height is ignored, so tracks
+//        that cross over themselves are not supported.
+//        Distances are stored as int16 cm (+-327 m, clamped). Offline only:
+//        the runtime fallback track (unbaked level) has no limits.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "RaceTrackLimits.generated.h"
+
+class URaceTrackData;
+
+USTRUCT(BlueprintType)
+struct ARCDUALDASH_API FRaceTrackLimits
+{
+    GENERATED_BODY()
+
+    // notes: world XY of the centre of cell (0, 0)
+    UPROPERTY(VisibleAnywhere, Category = "Track Limits")
+    FVector2f Origin = FVector2f::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, Category = "Track Limits")
+    float CellSize = 0.f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Track Limits")
+    int32 SizeX = 0;
+
+    UPROPERTY(VisibleAnywhere, Category = "Track Limits")
+    int32 SizeY = 0;
+
+    // notes: row-major (Y * SizeX + X), cm
+    UPROPERTY()
+    TArray<int16> Distances;
+
+    bool IsValid() const { return SizeX >= 2 && SizeY >= 2 && Distances.Num() == SizeX * SizeY; }
+
+    // notes: signed distance to the track edge at Location (cm); outside the grid the
+    //        distance to the grid is added. Callers check IsValid() first.
+    float Sample(const FVector& Location) const;
+
+    // notes: bakes the field from Track's gates and centreline; returns false (and logs)
+    //        if a gate has no width. CellSize grows if the grid would be too large.
+    bool Bake(const URaceTrackData& Track, float InCellSize);
+
+    void Reset();
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+// ============================================================================
+// RaceTrackLine.h
+// purpose: track centreline as a polyline + cumulative lengths, so any system
+//          can turn "distance along the lap" into a world position and back.
+// used by: RaceTrackData (owns the baked line), RaceLineData (racing line),
+//          RaceGameState, AMyCar (proxy cars), RaceStreamingSubsystem.
+// notes: built from the ordered checkpoint gates at bake time; closed loop by default.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "RaceTrackLine.generated.h"
+
+USTRUCT(BlueprintType)
+struct ARCDUALDASH_API FRaceTrackLine
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    TArray<FVector> Points;
+
+    // notes: CumulativeLength[i] = distance from Points[0] to Points[i]; one extra entry when closed
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    TArray<float> CumulativeLength;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Track")
+    bool bClosedLoop = true;
+
+    void Build(const TArray<FVector>& InPoints, bool bInClosedLoop = true);
+
+    bool IsValid() const { return Points.Num() >= 2; }
+    int32 NumSegments() const { return bClosedLoop ? Points.Num() : Points.Num() - 1; }
+    float GetLength() const { return CumulativeLength.Num() > 0 ? CumulativeLength.Last() : 0.f; }
+
+    // notes: wraps Distance into [0, Length) on closed loops, clamps otherwise
+    float WrapDistance(float Distance) const;
+
+    // notes: position + unit direction at Distance along the line
+    void Sample(float Distance, FVector& OutLocation, FVector& OutDirection) const;
+
+    // notes: segment holding Distance (wrapped) and the fraction [0, 1] along it, for per-point data
+    int32 Locate(float Distance, float& OutAlpha) const;
+
+    // notes: closest distance along the line to Location (brute force over segments)
+    float Project(const FVector& Location, int32* OutSegment = nullptr) const;
+
+    // notes: same, but only searches segments around HintSegment (cheap per-frame tracking)
+    float ProjectNear(const FVector& Location, int32 HintSegment, int32 SearchRadius, int32* OutSegment = nullptr) const;
+
+private:
+    float ProjectOnSegment(int32 Segment, const FVector& Location, float& OutDistSq) const;
+    int32 FindSegment(float Distance) const;
+};
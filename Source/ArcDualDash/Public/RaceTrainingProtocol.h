@@ -0,0 +1,87 @@
+#pragma once
+
+// ============================================================================
+// RaceTrainingProtocol.h
+// purpose: byte layout of the shared-memory region used by the training step
+//          API (RaceTrainingSubsystem). Plain C structs, little endian, so an
+//          external trainer can mirror them (ctypes / numpy) without UE headers.
+// layout:  [FRaceTrainingHeader][FRaceTrainingAction x MaxCars][FRaceTrainingObservation x MaxCars]
+// step:    trainer                               game
+//          write Actions[0..NumCars), Command
+//          ActionSeq += 1                  ->    applies actions, runs one fixed step
+//                                                writes Observations, StepIndex
+//          wait ObservationSeq == ActionSeq <-   ObservationSeq = ActionSeq
+// notes:   bump RaceTraining::Version whenever a struct below changes.
+// ============================================================================
+#include "CoreMinimal.h"
+
+namespace RaceTraining
+{
+    constexpr uint32 Magic = 0x54435241; // "ARCT"
+    constexpr uint32 Version = 2;
+}
+
+enum class ERaceTrainingCommand : uint32
+{
+    Step = 0,   // apply actions, advance one step
+    Reset = 1,  // every car back to its spawn, race clock restarted, then one step
+    Quit = 2,   // game exits after acknowledging
+};
+
+struct alignas(64) FRaceTrainingHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 MaxCars;
+    uint32 NumCars;         // game -> trainer: cars actually driven (<= MaxCars)
+    float StepSeconds;      // simulated seconds per step
+    uint32 Command;         // trainer -> game: ERaceTrainingCommand
+    uint64 StepIndex;       // steps run since the game attached
+    volatile int64 ActionSeq;       // trainer bumps after writing actions
+    volatile int64 ObservationSeq;  // game echoes ActionSeq after writing observations
+};
+
+struct FRaceTrainingAction
+{
+    float Throttle;         // -1..1
+    float Steering;         // -1..1
+    float Brake;            // 0..1
+    uint32 bHandbrake;
+};
+
+struct FRaceTrainingObservation
+{
+    float Speed;                    // cm/s, from the physics step
+    float Progress;                 // laps completed + fraction of the lap along the track line
+    float DistanceToNextCheckpoint; // cm
+    int32 Lap;
+    int32 CheckpointIndex;
+    uint32 bCrashed;
+    float Location[3];
+    float Yaw;                      // degrees
+    float LineOffset;               // cm right of the guide line (racing line if baked, else centreline)
+    float TargetSpeed;              // cm/s, racing line speed target here; 0 if the track has none
+};
+
+static_assert(sizeof(FRaceTrainingHeader) == 64, "training header layout changed; bump RaceTraining::Version");
+static_assert(sizeof(FRaceTrainingAction) == 16, "training action layout changed; bump RaceTraining::Version");
+static_assert(sizeof(FRaceTrainingObservation) == 48, "training observation layout changed; bump RaceTraining::Version");
+
+namespace RaceTraining
+{
+    inline SIZE_T GetRegionSize(uint32 MaxCars)
+    {
+        return sizeof(FRaceTrainingHeader) + MaxCars * (sizeof(FRaceTrainingAction) + sizeof(FRaceTrainingObservation));
+    }
+
+    inline FRaceTrainingAction* GetActions(void* Region)
+    {
+        return reinterpret_cast<FRaceTrainingAction*>(static_cast<uint8*>(Region) + sizeof(FRaceTrainingHeader));
+    }
+
+    inline FRaceTrainingObservation* GetObservations(void* Region, uint32 MaxCars)
+    {
+        return reinterpret_cast<FRaceTrainingObservation*>(
+            static_cast<uint8*>(Region) + sizeof(FRaceTrainingHeader) + MaxCars * sizeof(FRaceTrainingAction));
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// ============================================================================
+// RaceTrainingSubsystem.h
+// purpose: synchronous step API for bot training / evaluation. An external
+//          local process writes per-car actions into a named shared-memory
+//          region; each engine frame is exactly one fixed race logic step,
+//          after which observations are written back (RaceTrainingProtocol.h).
+// run:     ArcDualDashServer <track map> -nullrhi -RaceTraining=<region name>
+//              [-RaceTrainingCars=N] [-RaceInstances=K]
+//          With -RaceInstances the cars of every instance world are exposed
+//          back to back (batched environments); otherwise the host world's.
+// why:     no rendering, no sockets, no real-time pacing -> steps run as fast
+//          as the simulation does.
+// notes:   the engine blocks at the start of each frame until the trainer
+//          posts actions (TrainingWaitTimeoutSeconds, then quits).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RaceTrainingSubsystem.generated.h"
+
+class AMyCar;
+struct FRaceTrainingHeader;
+
+UCLASS()
+class ARCDUALDASH_API URaceTrainingSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // notes: only exists with -RaceTraining=<region> on the command line
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+private:
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+
+    // --- frame bracket: actions in before the world ticks, observations out after ---
+    void HandleBeginFrame();
+    void HandleEndFrame();
+
+    bool WaitForActions();
+    void GatherCars();
+    void ApplyActions();
+    void ResetEpisode();
+    void WriteObservations();
+
+    void GetTrainingWorlds(TArray<UWorld*, TInlineAllocator<8>>& OutWorlds) const;
+
+    FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+    FRaceTrainingHeader* Header = nullptr;
+
+    UPROPERTY()
+    TArray<TObjectPtr<AMyCar>> Cars;
+
+    // notes: last track-line segment per car, keeps the progress projection local
+    TArray<int32> ProgressSegments;
+
+    // notes: same for the guide line (racing line offset / speed target)
+    TArray<int32> GuideSegments;
+
+    FString RegionName;
+    uint32 MaxCars = 0;
+    int64 LastActionSeq = 0;
+    bool bMapReady = false;
+    bool bStepPending = false;
+
+    FDelegateHandle PostLoadMapHandle;
+    FDelegateHandle BeginFrameHandle;
+    FDelegateHandle EndFrameHandle;
+};
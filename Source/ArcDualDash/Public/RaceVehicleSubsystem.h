@@ -0,0 +1,77 @@
+#pragma once
+
+// ============================================================================
+// RaceVehicleSubsystem.h
+// purpose: registry of live AMyCar in the world + vehicle simulation LOD.
+//          Full    -> near a local viewpoint: full Chaos sim, anim, tick
+//          Reduced -> mid range: actor + vehicle component tick throttled only;
+//                     the Chaos vehicle sim itself still runs every physics step
+//          Proxy   -> far AI cars: physics off, moved kinematically along
+//                     the track line at their last speed
+//          Also owns the per-frame car proximity grid (slipstream / drafting).
+// used by: AMyCar (register / SetSimLOD), anything that needs "all cars"
+//          without GetAllActorsOfClass.
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RaceProximityGrid.h"
+#include "RaceVehicleSubsystem.generated.h"
+
+class AMyCar;
+
+UENUM(BlueprintType)
+enum class ERaceSimLOD : uint8
+{
+    Full,
+    Reduced,
+    Proxy
+};
+
+// notes: one per local player view (split-screen -> 2); server falls back to player pawns
+struct FRaceViewpoint
+{
+    FVector Location = FVector::ZeroVector;
+    FVector Forward = FVector::ForwardVector;
+    float FOVDegrees = 90.f;
+};
+
+typedef TArray<FRaceViewpoint, TInlineAllocator<4>> FRaceViewpointArray;
+
+UCLASS()
+class ARCDUALDASH_API URaceVehicleSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void RegisterCar(AMyCar* Car);
+    void UnregisterCar(AMyCar* Car);
+
+    const TArray<AMyCar*>& GetCars() const { return Cars; }
+
+    // notes: every local player's camera; if none (dedicated server) the player-controlled cars
+    static void GatherViewpoints(const UWorld* World, FRaceViewpointArray& OutViewpoints);
+
+    static float MinDistanceToViewpoints(const FRaceViewpointArray& Viewpoints, const FVector& Location);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void UpdateSimLOD();
+    ERaceSimLOD PickTier(const AMyCar* Car, float Distance) const;
+
+    // notes: rebuilds the proximity grid and hands every car its draft strength (authority only)
+    void UpdateSlipstream();
+
+    UPROPERTY()
+    TArray<AMyCar*> Cars;
+
+    // notes: rebuilt every frame; position array kept to reuse its allocation
+    FRaceProximityGrid ProximityGrid;
+    TArray<FVector> CarPositions;
+
+    float TimeSinceLODUpdate = 0.f;
+};
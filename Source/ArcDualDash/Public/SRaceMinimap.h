@@ -0,0 +1,67 @@
+#pragma once
+
+// ============================================================================
+// SRaceMinimap.h
+// purpose: native top-down minimap, one per local player (split-screen pane).
+//          Track outline comes from the baked centreline: normalised once,
+//          re-laid out only when the widget size changes, drawn as one line
+//          element. Car + collectable markers are rebuilt from the vehicle /
+//          significance registries each paint into a single vertex list, drawn
+//          as one custom-verts element.
+// why: a SceneCapture2D minimap re-renders the scene per player per frame;
+//      this costs a few hundred vertices.
+// used by: ARacePlayerController (added next to the HUD widget).
+// notes: world +X is up on the map. Game thread only (OnPaint).
+// ============================================================================
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Rendering/RenderingCommon.h"
+
+class APlayerController;
+
+class ARCDUALDASH_API SRaceMinimap : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SRaceMinimap)
+        : _Size(220.f)
+        , _MarkerSize(8.f)
+    {}
+        SLATE_ARGUMENT(TWeakObjectPtr<APlayerController>, OwningPlayer)
+        SLATE_ARGUMENT(float, Size)
+        SLATE_ARGUMENT(float, MarkerSize)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+    // notes: false until the game state has track data
+    bool CacheOutline(const UWorld& World) const;
+
+    FVector2f WorldToMap(const FVector& Location, const FVector2f& MapSize) const;
+    void AddMarker(const FSlateRenderTransform& Transform, const FVector2f& Center, float HalfSize, const FColor& Color) const;
+
+    TWeakObjectPtr<APlayerController> OwningPlayer;
+    float Size = 220.f;
+    float MarkerSize = 8.f;
+
+    // --- track outline (map units: [0, 1] on the longer world axis) ---
+    mutable TArray<FVector2f> NormalizedOutline;
+    mutable FVector2f WorldMin = FVector2f::ZeroVector;
+    mutable float WorldToUnit = 0.f;
+    mutable FVector2f UnitExtent = FVector2f::ZeroVector;
+
+    // notes: NormalizedOutline laid out for LaidOutSize; rebuilt on resize only
+    mutable TArray<FVector2f> OutlinePoints;
+    mutable FVector2f LaidOutSize = FVector2f::ZeroVector;
+
+    // --- markers: one vertex / index list per paint, allocation kept ---
+    mutable TArray<FSlateVertex> MarkerVerts;
+    mutable TArray<SlateIndex> MarkerIndices;
+    FSlateResourceHandle WhiteHandle;
+};